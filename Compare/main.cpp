@@ -0,0 +1,216 @@
+#include "../Task3/bump.h"
+#include "../Task3/bench.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Optimisation level this binary was built at, passed in by the Makefile
+#ifndef OPT_LEVEL
+#define OPT_LEVEL "unknown"
+#endif
+
+// A fixed sequence of allocation sizes, replayed on every pass so each allocator sees identical requests
+struct workload
+{
+    std::string name;
+    std::vector<std::size_t> sizes;
+};
+
+// Every allocator hands out blocks with the alignment malloc guarantees
+constexpr std::size_t block_alignment = alignof(std::max_align_t);
+
+// Pool size of the fixed arenas, enough for one pass of the largest workload
+constexpr std::size_t pool_bytes = 64 << 20;
+
+typedef bump::bump_up<pool_bytes> fixed_up;
+typedef bump::bump_down<pool_bytes> fixed_down;
+typedef bump::bump_up<1 << 16, bump::growth::geometric<>> chained_up;
+
+workload TinySizes(void);
+workload MixedSizes(void);
+workload PowerLawSizes(void);
+workload LargeSizes(void);
+
+void MallocPass(const workload &);
+void NewDeletePass(const workload &);
+void MonotonicPass(std::pmr::monotonic_buffer_resource &, const workload &);
+template <class Arena>
+void ArenaPass(Arena &, const workload &);
+
+template <class Function, class... Args>
+void Compare(const workload &, const std::string &, Function, Args &&...);
+
+// Pointers of the current pass, kept outside the timed code so every allocator does the same bookkeeping
+static std::vector<void *> live;
+
+int main(int argc, char **argv)
+{
+    // --no-header continues a table started by another build of this file
+    bool header = true;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--no-header")
+            header = false;
+    }
+
+    benchmark::settings().verbose = false;
+    benchmark::settings().warmup_runs = 3;
+
+    std::vector<workload> workloads = {TinySizes(), MixedSizes(), PowerLawSizes(), LargeSizes()};
+
+    static fixed_up up_arena;
+    static fixed_down down_arena;
+    static chained_up chained_arena;
+    static std::vector<std::byte> monotonic_buffer(pool_bytes);
+    std::pmr::monotonic_buffer_resource monotonic(monotonic_buffer.data(), monotonic_buffer.size());
+
+    if (header)
+    {
+        std::cout << std::left << std::setw(6) << "Opt" << std::setw(12) << "Sizes" << std::setw(28) << "Allocator"
+                  << std::right << std::setw(8) << "Ops" << std::setw(14) << "Mops/s" << std::setw(18) << "Median pass ns/op"
+                  << std::setw(18) << "P99 pass ns/op" << "\n";
+        std::cout << std::string(104, '-') << "\n";
+    }
+
+    for (const workload &sizes : workloads)
+    {
+        live.assign(sizes.sizes.size(), nullptr);
+
+        // Each benchmark call is one full pass: allocate and touch every block, then free them all
+        Compare(sizes, "malloc/free", MallocPass, sizes);
+        Compare(sizes, "new/delete", NewDeletePass, sizes);
+        Compare(sizes, "pmr::monotonic (64MB buffer)", MonotonicPass, monotonic, sizes);
+        Compare(sizes, "bump_up (64MB)", ArenaPass<fixed_up>, up_arena, sizes);
+        Compare(sizes, "bump_down (64MB)", ArenaPass<fixed_down>, down_arena, sizes);
+        Compare(sizes, "bump_up (geometric chunks)", ArenaPass<chained_up>, chained_arena, sizes);
+    }
+}
+
+// Uniform 8 to 64 bytes, small nodes and strings
+workload TinySizes(void)
+{
+    std::mt19937_64 random(1);
+    std::uniform_int_distribution<std::size_t> size(8, 64);
+    workload sizes{"tiny", {}};
+    for (int i = 0; i < 4096; ++i)
+        sizes.sizes.push_back(size(random));
+    return sizes;
+}
+
+// Mostly small with a share of medium buffers: 70% 16-128, 25% 128-1024 and 5% 1-4KB
+workload MixedSizes(void)
+{
+    std::mt19937_64 random(2);
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::uniform_int_distribution<std::size_t> small(16, 128), medium(128, 1024), big(1024, 4096);
+    workload sizes{"mixed", {}};
+    for (int i = 0; i < 2048; ++i)
+    {
+        int p = pick(random);
+        sizes.sizes.push_back(p < 70 ? small(random) : p < 95 ? medium(random) : big(random));
+    }
+    return sizes;
+}
+
+// Pareto distributed from 16 bytes with a heavy tail capped at 256KB, like real object size histograms
+workload PowerLawSizes(void)
+{
+    std::mt19937_64 random(3);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    workload sizes{"power-law", {}};
+    for (int i = 0; i < 2048; ++i)
+    {
+        double size = 16.0 / std::pow(1.0 - unit(random), 1.0 / 1.2);
+        sizes.sizes.push_back(static_cast<std::size_t>(std::min(size, 256.0 * 1024.0)));
+    }
+    return sizes;
+}
+
+// Uniform 64KB to 1MB, above glibc's mmap threshold for most requests
+workload LargeSizes(void)
+{
+    std::mt19937_64 random(4);
+    std::uniform_int_distribution<std::size_t> size(64 << 10, 1 << 20);
+    workload sizes{"large", {}};
+    for (int i = 0; i < 48; ++i)
+        sizes.sizes.push_back(size(random));
+    return sizes;
+}
+
+void MallocPass(const workload &sizes)
+{
+    for (std::size_t i = 0; i < sizes.sizes.size(); ++i)
+    {
+        char *p = static_cast<char *>(std::malloc(sizes.sizes[i]));
+        p[0] = 1;
+        live[i] = p;
+    }
+    benchmark::clobber_memory();
+    for (void *p : live)
+        std::free(p);
+}
+
+void NewDeletePass(const workload &sizes)
+{
+    for (std::size_t i = 0; i < sizes.sizes.size(); ++i)
+    {
+        char *p = new char[sizes.sizes[i]];
+        p[0] = 1;
+        live[i] = p;
+    }
+    benchmark::clobber_memory();
+    for (void *p : live)
+        delete[] static_cast<char *>(p);
+}
+
+void MonotonicPass(std::pmr::monotonic_buffer_resource &resource, const workload &sizes)
+{
+    for (std::size_t i = 0; i < sizes.sizes.size(); ++i)
+    {
+        char *p = static_cast<char *>(resource.allocate(sizes.sizes[i], block_alignment));
+        p[0] = 1;
+        live[i] = p;
+    }
+    benchmark::clobber_memory();
+    resource.release();
+}
+
+template <class Arena>
+void ArenaPass(Arena &arena, const workload &sizes)
+{
+    for (std::size_t i = 0; i < sizes.sizes.size(); ++i)
+    {
+        char *p = static_cast<char *>(arena.allocate_bytes(sizes.sizes[i], block_alignment));
+        if (p)
+            p[0] = 1;
+        live[i] = p;
+    }
+    benchmark::clobber_memory();
+    arena.reset();
+}
+
+// Measure one allocator on one workload and print its line of the comparison table
+// Per-operation figures are a whole pass divided by its allocation count, so the p99 column is the p99 pass
+// spread over its allocations and not the p99 latency of a single allocation
+template <class Function, class... Args>
+void Compare(const workload &sizes, const std::string &allocator, Function func, Args &&...args)
+{
+    benchmark::run_benchmark(sizes.name + " " + allocator, 50, func, std::forward<Args>(args)...);
+    const benchmark::result &pass = benchmark::results().back();
+
+    double per_op = static_cast<double>(sizes.sizes.size());
+    std::cout << std::left << std::setw(6) << OPT_LEVEL << std::setw(12) << sizes.name << std::setw(28) << allocator
+              << std::right << std::setw(8) << sizes.sizes.size() << std::fixed << std::setprecision(2)
+              << std::setw(14) << per_op * 1000.0 / pass.mean_ns
+              << std::setw(18) << pass.median_ns / per_op
+              << std::setw(18) << pass.p99_ns / per_op << "\n";
+}
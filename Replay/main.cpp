@@ -0,0 +1,236 @@
+#include "../Task3/bump.h"
+#include "../Task3/bench.h"
+#include "../Task3/trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Arenas chain chunks so any trace fits, the counting variants are only used to measure the footprint
+typedef bump::bump_up<1 << 16, bump::growth::geometric<>> replay_up;
+typedef bump::bump_down<1 << 16, bump::growth::geometric<>> replay_down;
+typedef bump::bump_up<1 << 16, bump::growth::geometric<>, bump::backing::heap, bump::stats::counting> counted_up;
+typedef bump::bump_down<1 << 16, bump::growth::geometric<>, bump::backing::heap, bump::stats::counting> counted_down;
+
+typedef std::vector<bump::trace_event> trace;
+
+// Memory resource that forwards to new/delete and keeps the peak number of bytes it handed out
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+    std::size_t peak() const { return peak_bytes; }
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        current += bytes;
+        peak_bytes = std::max(peak_bytes, current);
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+    {
+        current -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::size_t current = 0;
+    std::size_t peak_bytes = 0;
+};
+
+template <class Arena>
+void ReplayArena(Arena &, const trace &);
+template <bool Measure>
+std::size_t ReplayMalloc(const trace &);
+void ReplayMonotonic(std::pmr::memory_resource *, const trace &);
+std::size_t PeakLiveBytes(const trace &);
+void PrintRow(const std::string &, std::size_t, std::size_t, std::size_t);
+
+// Replays are timed in batches that end with everything released, so every run starts from the same state
+int main(int argc, char **argv)
+{
+    std::size_t runs = 10;
+    if (argc > 2)
+    {
+        // Runs must be a positive integer with nothing after it, anything else is reported as 0
+        char *end;
+        errno = 0;
+        runs = std::strtoull(argv[2], &end, 10);
+        if (end == argv[2] || *end != '\0' || errno != 0 || argv[2][0] == '-')
+            runs = 0;
+    }
+    if (argc < 2 || runs < 1)
+    {
+        std::cerr << "Usage: " << argv[0] << " <trace file> [runs]" << std::endl;
+        return 1;
+    }
+
+    trace events;
+    try
+    {
+        events = bump::read_trace(argv[1]);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    benchmark::settings().verbose = false;
+    benchmark::settings().warmup_runs = 1;
+
+    std::size_t allocations = std::count_if(events.begin(), events.end(), [](const bump::trace_event &e)
+                                            { return e.kind == bump::trace_kind::allocate; });
+    std::size_t live = PeakLiveBytes(events);
+    std::cout << events.size() << " events, " << allocations << " allocations, peak live " << live << " bytes\n\n";
+
+    std::cout << std::left << std::setw(24) << "Allocator" << std::right << std::setw(16) << "Median us/run"
+              << std::setw(12) << "Mops/s" << std::setw(16) << "Peak KB" << std::setw(16) << "Fragmentation" << "\n";
+    std::cout << std::string(84, '-') << "\n";
+
+    // Bump up
+    static replay_up up;
+    static counted_up counted_up_arena;
+    benchmark::run_benchmark("bump_up", runs, ReplayArena<replay_up>, up, events);
+    ReplayArena(counted_up_arena, events);
+    PrintRow("bump_up (geometric)", allocations, live, counted_up_arena.statistics().high_water);
+
+    // Bump down
+    static replay_down down;
+    static counted_down counted_down_arena;
+    benchmark::run_benchmark("bump_down", runs, ReplayArena<replay_down>, down, events);
+    ReplayArena(counted_down_arena, events);
+    PrintRow("bump_down (geometric)", allocations, live, counted_down_arena.statistics().high_water);
+
+    // malloc/free, everything allocated before a reset is freed at the reset
+    benchmark::run_benchmark("malloc", runs, ReplayMalloc<false>, events);
+    PrintRow("malloc/free", allocations, live, ReplayMalloc<true>(events));
+
+    // std::pmr::monotonic_buffer_resource, released at every reset
+    counting_resource upstream;
+    benchmark::run_benchmark("monotonic", runs, ReplayMonotonic, std::pmr::new_delete_resource(), events);
+    ReplayMonotonic(&upstream, events);
+    PrintRow("pmr::monotonic", allocations, live, upstream.peak());
+}
+
+template <class Arena>
+void ReplayArena(Arena &arena, const trace &events)
+{
+    for (const bump::trace_event &e : events)
+    {
+        if (e.kind == bump::trace_kind::reset)
+        {
+            arena.reset();
+            continue;
+        }
+
+        char *p = static_cast<char *>(arena.allocate_bytes(e.size, std::size_t(1) << e.align_log2));
+        if (p)
+            p[0] = 1;
+    }
+    arena.reset();
+}
+
+// Returns the peak of what malloc reports as usable for the live blocks when Measure is set, 0 otherwise
+// Without glibc the requested sizes are used, which leaves malloc's own overhead out
+template <bool Measure>
+std::size_t ReplayMalloc(const trace &events)
+{
+    static std::vector<void *> live;
+    std::size_t current = 0, peak = 0;
+
+    for (const bump::trace_event &e : events)
+    {
+        if (e.kind == bump::trace_kind::reset)
+        {
+            for (void *p : live)
+                std::free(p);
+            live.clear();
+            current = 0;
+            continue;
+        }
+
+        std::size_t alignment = std::size_t(1) << e.align_log2;
+        char *p;
+        if (alignment <= alignof(std::max_align_t))
+            p = static_cast<char *>(std::malloc(e.size));
+        else
+            p = static_cast<char *>(std::aligned_alloc(alignment, (e.size + alignment - 1) & ~(alignment - 1)));
+        if (p == nullptr)
+            continue;
+        p[0] = 1;
+        live.push_back(p);
+
+        if constexpr (Measure)
+        {
+#if defined(__GLIBC__)
+            current += malloc_usable_size(p);
+#else
+            current += e.size;
+#endif
+            peak = std::max(peak, current);
+        }
+    }
+
+    for (void *p : live)
+        std::free(p);
+    live.clear();
+    return peak;
+}
+
+void ReplayMonotonic(std::pmr::memory_resource *upstream, const trace &events)
+{
+    std::pmr::monotonic_buffer_resource resource(upstream);
+    for (const bump::trace_event &e : events)
+    {
+        if (e.kind == bump::trace_kind::reset)
+        {
+            resource.release();
+            continue;
+        }
+
+        char *p = static_cast<char *>(resource.allocate(e.size, std::size_t(1) << e.align_log2));
+        p[0] = 1;
+    }
+}
+
+// Largest number of requested bytes alive at once, the footprint a perfect allocator would need
+std::size_t PeakLiveBytes(const trace &events)
+{
+    std::size_t current = 0, peak = 0;
+    for (const bump::trace_event &e : events)
+    {
+        current = e.kind == bump::trace_kind::reset ? 0 : current + e.size;
+        peak = std::max(peak, current);
+    }
+    return peak;
+}
+
+// One line of the table, using the timing just collected by run_benchmark
+// Fragmentation is the share of the peak footprint that never held requested bytes
+void PrintRow(const std::string &allocator, std::size_t allocations, std::size_t live, std::size_t footprint)
+{
+    const benchmark::result &timing = benchmark::results().back();
+    double fragmentation = footprint ? 100.0 * (1.0 - static_cast<double>(live) / static_cast<double>(footprint)) : 0.0;
+
+    std::cout << std::left << std::setw(24) << allocator << std::right << std::fixed << std::setprecision(2)
+              << std::setw(16) << timing.median_ns / 1000.0
+              << std::setw(12) << static_cast<double>(allocations) * 1000.0 / timing.median_ns
+              << std::setw(16) << static_cast<double>(footprint) / 1024.0
+              << std::setw(15) << fragmentation << "%\n";
+}
@@ -74,6 +74,13 @@ public:
         }
     }
 
+    // Rewind next to the start of the pool while keeping its memory for reuse
+    void reset()
+    {
+        if (pool)
+            next = pool;
+    }
+
     // Print the next address in the pool
     void print_next_addr() const
     {
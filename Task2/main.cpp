@@ -73,6 +73,19 @@ DEFINE_TEST_G(DeallocateTest, Bump)
     TEST_MESSAGE(y != nullptr, "Failed to allocate 10 ints after deallocation.");
 }
 
+DEFINE_TEST_G(ResetTest, Bump)
+{
+    bump<20 * sizeof(int)> bumper;
+
+    int *x = bumper.allocate<int>(20);
+    TEST_MESSAGE(x != nullptr, "Failed to allocate 20 ints.");
+
+    bumper.reset();
+
+    int *y = bumper.allocate<int>(20);
+    TEST_MESSAGE(y == x, "Reset did not rewind to the start of the same pool.");
+}
+
 DEFINE_TEST_G(MixedAllocationsAndDeallocationTest, Bump)
 {
     bump<20 * sizeof(int)> bumper;
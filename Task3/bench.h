@@ -4,6 +4,32 @@
 #include <chrono>
 #include <utility>
 #include <functional>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 // Macro to get the current time
 #define time_now() std::chrono::high_resolution_clock::now();
@@ -17,35 +43,541 @@ namespace benchmark
     // Alias for a time point using high-resolution clock
     typedef std::chrono::high_resolution_clock::time_point time_point;
 
+    // Formats the collected results can be written in
+    enum class format
+    {
+        text, // Human readable lines only, nothing is written at the end
+        json,
+        csv
+    };
+
+    // Settings shared by every run_benchmark call, see configure()
+    struct options
+    {
+        std::size_t warmup_runs = 10;     // Untimed calls before measuring
+        double min_sample_ns = 20000.0;   // Calls are batched until one sample takes at least this long
+        std::size_t max_batch = 1 << 16;  // Upper bound on calls per sample
+        bool use_tsc = false;             // Also record time stamp counter cycles (x86 only)
+        bool verbose = true;              // Print each result as soon as it is measured
+        bool counters = false;            // Also collect hardware counters, page faults and peak RSS
+        format output = format::text;     // Format written by finish()
+        std::string output_path;          // File written by finish(), standard output when empty
+    };
+
+    // Hardware events collected when counters are enabled, in the order they are reported
+    constexpr std::size_t counter_count = 6;
+    inline const char *const counter_names[counter_count] = {"cycles", "instructions", "l1d_misses",
+                                                             "llc_misses", "dtlb_misses", "branch_misses"};
+
+    // Summary of one benchmark, every timing and counter figure is per call of the benchmarked function
+    struct result
+    {
+        std::string description;
+        std::size_t samples;
+        std::size_t batch;
+        double total_ns;
+        double min_ns;
+        double median_ns;
+        double mean_ns;
+        double p99_ns;
+        double stddev_ns;
+        double median_cycles; // 0 when cycles were not recorded
+        std::array<double, counter_count> counters; // -1 where the event was not collected
+        long minor_faults;    // Page faults over all measured calls, -1 when not collected
+        long major_faults;
+        long peak_rss_kb;     // Peak resident set size of the process so far, -1 when not collected
+    };
+
+    // Global settings, adjusted directly or through configure()
+    inline options &settings()
+    {
+        static options current;
+        return current;
+    }
+
+    // Every result collected so far, in the order the benchmarks ran
+    inline std::vector<result> &results()
+    {
+        static std::vector<result> collected;
+        return collected;
+    }
+
+    // Prevent the compiler from discarding value or the computation that produced it
+    template <class T>
+    inline void do_not_optimize(T const &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+    // Force every pending write to memory to be treated as observable
+    inline void clobber_memory()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    // Read the time stamp counter, 0 where it is not available
+    inline std::uint64_t read_cycles()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_lfence();
+        std::uint64_t cycles = __rdtsc();
+        _mm_lfence();
+        return cycles;
+#else
+        return 0;
+#endif
+    }
+
+    // Apply --format=text|json|csv, --output=path, --tsc, --counters, --warmup=N and --min-sample-ns=N
+    inline void configure(int argc, char **argv)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--format=json")
+                settings().output = format::json;
+            else if (arg == "--format=csv")
+                settings().output = format::csv;
+            else if (arg == "--format=text")
+                settings().output = format::text;
+            else if (arg.rfind("--output=", 0) == 0)
+                settings().output_path = arg.substr(9);
+            else if (arg == "--tsc")
+                settings().use_tsc = true;
+            else if (arg == "--counters")
+                settings().counters = true;
+            else if (arg.rfind("--warmup=", 0) == 0)
+                settings().warmup_runs = std::strtoull(arg.c_str() + 9, nullptr, 10);
+            else if (arg.rfind("--min-sample-ns=", 0) == 0)
+                settings().min_sample_ns = std::strtod(arg.c_str() + 16, nullptr);
+            else
+                std::cerr << "Unknown benchmark option: " << arg << std::endl;
+        }
+    }
+
+    namespace detail
+    {
+        // The counter_names events, counted in user space for the calling thread and the threads it starts
+        // Events the kernel refuses (perf_event_paranoid, containers, missing PMU) are left out, not fatal
+        class counter_set
+        {
+        public:
+            // Nothing is opened when enabled is false, every event then reads as not collected
+            explicit counter_set(bool enabled)
+            {
+                fds.fill(-1);
+#if defined(__linux__)
+                if (!enabled)
+                    return;
+
+                const std::uint32_t types[counter_count] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+                                                            PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+                const std::uint64_t configs[counter_count] = {
+                    PERF_COUNT_HW_CPU_CYCLES,
+                    PERF_COUNT_HW_INSTRUCTIONS,
+                    cache_event(PERF_COUNT_HW_CACHE_L1D),
+                    cache_event(PERF_COUNT_HW_CACHE_LL),
+                    cache_event(PERF_COUNT_HW_CACHE_DTLB),
+                    PERF_COUNT_HW_BRANCH_MISSES};
+
+                for (std::size_t i = 0; i < counter_count; ++i)
+                {
+                    perf_event_attr attr;
+                    std::memset(&attr, 0, sizeof(attr));
+                    attr.size = sizeof(attr);
+                    attr.type = types[i];
+                    attr.config = configs[i];
+                    attr.disabled = 1;
+                    attr.inherit = 1;
+                    attr.exclude_kernel = 1;
+                    attr.exclude_hv = 1;
+                    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                    fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+                    if (fds[i] < 0)
+                        error = errno;
+                }
+#endif
+            }
+
+            counter_set(const counter_set &) = delete;
+            counter_set &operator=(const counter_set &) = delete;
+
+            // Destructor
+            ~counter_set()
+            {
+#if defined(__linux__)
+                for (int fd : fds)
+                {
+                    if (fd >= 0)
+                        close(fd);
+                }
+#endif
+            }
+
+            // True if at least one event could be opened
+            bool any() const
+            {
+                return std::any_of(fds.begin(), fds.end(), [](int fd) { return fd >= 0; });
+            }
+
+            // errno of the last event that failed to open, 0 if none did
+            int last_error() const { return error; }
+
+            // Zero and start every open event
+            void start()
+            {
+#if defined(__linux__)
+                for (int fd : fds)
+                {
+                    if (fd >= 0)
+                    {
+                        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                    }
+                }
+#endif
+            }
+
+            // Stop every open event
+            void stop()
+            {
+#if defined(__linux__)
+                for (int fd : fds)
+                {
+                    if (fd >= 0)
+                        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                }
+#endif
+            }
+
+            // Counts since start() divided by calls, -1 for events that are not open or were never scheduled
+            // When there are more events than hardware counters the kernel multiplexes them, so each count is
+            // scaled up by the time its event was enabled over the time it was actually counting
+            std::array<double, counter_count> read(double calls) const
+            {
+                std::array<double, counter_count> values;
+                values.fill(-1.0);
+#if defined(__linux__)
+                for (std::size_t i = 0; i < counter_count; ++i)
+                {
+                    // Value, time enabled and time running, as requested by read_format
+                    std::uint64_t data[3];
+                    if (fds[i] < 0 || ::read(fds[i], data, sizeof(data)) != sizeof(data) || data[2] == 0)
+                        continue;
+
+                    double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+                    values[i] = static_cast<double>(data[0]) * scale / calls;
+                }
+#endif
+                return values;
+            }
+
+        private:
+#if defined(__linux__)
+            // Read misses of a hardware cache
+            static constexpr std::uint64_t cache_event(std::uint64_t cache)
+            {
+                return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            }
+#endif
+
+            std::array<int, counter_count> fds;
+            int error = 0;
+        }; // CLASS counter_set
+
+        // Report once per process that no hardware event could be opened
+        inline void warn_unavailable(int error)
+        {
+            static bool warned = false;
+            if (!warned)
+                std::cerr << "Hardware counters unavailable (" << std::strerror(error) << "), collecting page faults only" << std::endl;
+            warned = true;
+        }
+
+        // Minor faults, major faults and peak RSS in KB of the whole process, -1 each where unsupported
+        inline std::array<long, 3> resource_usage()
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) == 0)
+            {
+#if defined(__APPLE__)
+                long peak_kb = usage.ru_maxrss / 1024; // Reported in bytes on macOS
+#else
+                long peak_kb = usage.ru_maxrss;
+#endif
+                return {usage.ru_minflt, usage.ru_majflt, peak_kb};
+            }
+#endif
+            return {-1, -1, -1};
+        }
+
+        // Nearest-rank percentile of sorted samples
+        inline double percentile(const std::vector<double> &sorted, double p)
+        {
+            std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+            return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+        }
+
+        // Summarise per-call samples
+        inline result summarise(const std::string &description, std::vector<double> samples, std::size_t batch,
+                                std::vector<double> cycles)
+        {
+            std::sort(samples.begin(), samples.end());
+
+            double sum = 0.0;
+            for (double sample : samples)
+                sum += sample;
+            double mean = sum / static_cast<double>(samples.size());
+
+            double variance = 0.0;
+            for (double sample : samples)
+                variance += (sample - mean) * (sample - mean);
+            if (samples.size() > 1)
+                variance /= static_cast<double>(samples.size() - 1);
+
+            double median_cycles = 0.0;
+            if (!cycles.empty())
+            {
+                std::sort(cycles.begin(), cycles.end());
+                median_cycles = percentile(cycles, 50.0);
+            }
+
+            std::array<double, counter_count> not_collected;
+            not_collected.fill(-1.0);
+
+            return result{description, samples.size(), batch, sum * static_cast<double>(batch), samples.front(),
+                          percentile(samples, 50.0), mean, percentile(samples, 99.0), std::sqrt(variance), median_cycles,
+                          not_collected, -1, -1, -1};
+        }
+
+        // Quote a description for JSON (backslash escapes) or CSV (doubled quotes) output
+        inline std::string quoted(const std::string &text, format style)
+        {
+            std::string out = "\"";
+            for (char c : text)
+            {
+                if (c == '"' || (c == '\\' && style == format::json))
+                    out += style == format::json ? '\\' : '"';
+                out += c;
+            }
+            return out + "\"";
+        }
+    } // namespace detail
+
+    // Write every collected result in the given format
+    inline void report(std::ostream &out, format style)
+    {
+        if (style == format::json)
+        {
+            out << "[\n";
+            for (std::size_t i = 0; i < results().size(); ++i)
+            {
+                const result &r = results()[i];
+                out << "  {\"description\": " << detail::quoted(r.description, style) << ", \"samples\": " << r.samples
+                    << ", \"batch\": " << r.batch << ", \"min_ns\": " << r.min_ns << ", \"median_ns\": " << r.median_ns
+                    << ", \"mean_ns\": " << r.mean_ns << ", \"p99_ns\": " << r.p99_ns << ", \"stddev_ns\": " << r.stddev_ns
+                    << ", \"median_cycles\": " << r.median_cycles;
+                for (std::size_t c = 0; c < counter_count; ++c)
+                {
+                    out << ", \"" << counter_names[c] << "\": ";
+                    if (r.counters[c] >= 0)
+                        out << r.counters[c];
+                    else
+                        out << "null";
+                }
+
+                // Usage figures that were not collected are null like the counters
+                const std::pair<const char *, long> usage[] = {
+                    {"minor_faults", r.minor_faults}, {"major_faults", r.major_faults}, {"peak_rss_kb", r.peak_rss_kb}};
+                for (const auto &[name, value] : usage)
+                {
+                    out << ", \"" << name << "\": ";
+                    if (value >= 0)
+                        out << value;
+                    else
+                        out << "null";
+                }
+                out << "}" << (i + 1 < results().size() ? "," : "") << "\n";
+            }
+            out << "]\n";
+        }
+        else if (style == format::csv)
+        {
+            out << "description,samples,batch,min_ns,median_ns,mean_ns,p99_ns,stddev_ns,median_cycles";
+            for (const char *name : counter_names)
+                out << ',' << name;
+            out << ",minor_faults,major_faults,peak_rss_kb\n";
+
+            for (const result &r : results())
+            {
+                out << detail::quoted(r.description, style) << ',' << r.samples << ',' << r.batch << ',' << r.min_ns << ','
+                    << r.median_ns << ',' << r.mean_ns << ',' << r.p99_ns << ',' << r.stddev_ns << ',' << r.median_cycles;
+
+                // Events and usage figures that were not collected are left empty
+                for (double count : r.counters)
+                {
+                    out << ',';
+                    if (count >= 0)
+                        out << count;
+                }
+                for (long value : {r.minor_faults, r.major_faults, r.peak_rss_kb})
+                {
+                    out << ',';
+                    if (value >= 0)
+                        out << value;
+                }
+                out << "\n";
+            }
+        }
+    }
+
+    // Write the collected results as configured, call once after the last benchmark
+    inline void finish()
+    {
+        if (settings().output == format::text)
+            return;
+
+        if (settings().output_path.empty())
+        {
+            report(std::cout, settings().output);
+            return;
+        }
+
+        std::ofstream file(settings().output_path);
+        report(file, settings().output);
+    }
+
     // Function to run a benchmark for a given function
+    // runs is the number of timed samples. With more than one, the function is first warmed up and then called
+    // in batches sized so each sample is long enough for the clock, and every figure is reported per call.
+    // A single run is measured cold, exactly once, for benchmarks of first-time costs such as page faults.
+    // Returns the mean time per call in nanoseconds.
     template <typename Function, typename... Args>
     double run_benchmark(const std::string &description, std::size_t runs, Function func, Args &&...args)
     {
-        double total_time = 0.0;
+        // Check if the number of runs is valid, every statistic needs at least one sample
+        if (runs < 1)
+            throw std::invalid_argument("Invalid. Runs must be greater than 0.");
+
+        const options &config = settings();
+        std::size_t batch = 1;
+
+        if (runs > 1)
+        {
+            // Warm up caches, branch predictors and lazily initialised state
+            for (std::size_t i = 0; i < config.warmup_runs; ++i)
+            {
+                func(std::forward<Args>(args)...);
+                clobber_memory();
+            }
+
+            // Double the batch until one batch takes long enough to measure reliably
+            while (batch < config.max_batch)
+            {
+                time_point start = time_now();
+                for (std::size_t i = 0; i < batch; ++i)
+                {
+                    func(std::forward<Args>(args)...);
+                    clobber_memory();
+                }
+                time_point end = time_now();
+
+                double elapsed = duration(end - start);
+                if (elapsed >= config.min_sample_ns)
+                    break;
+                batch *= 2;
+            }
+        }
+
+        std::vector<double> samples;
+        std::vector<double> cycles;
+        samples.reserve(runs);
+
+        // Counters and fault counts cover every timed call, warm-up and calibration excluded
+        detail::counter_set events(config.counters);
+        if (config.counters && !events.any())
+            detail::warn_unavailable(events.last_error());
+        std::array<long, 3> usage_before = detail::resource_usage();
+        events.start();
 
         // Loop for the specified number of runs
-        for (std::size_t i = 0; i < runs; ++i)
+        for (std::size_t run = 0; run < runs; ++run)
         {
             // Record the start time
+            std::uint64_t start_cycles = config.use_tsc ? read_cycles() : 0;
             time_point start = time_now();
 
             // Call the provided function using std::forward
-            func(std::forward<Args>(args)...);
+            for (std::size_t i = 0; i < batch; ++i)
+            {
+                func(std::forward<Args>(args)...);
+                clobber_memory();
+            }
 
             // Record the end time
             time_point end = time_now();
+            std::uint64_t end_cycles = config.use_tsc ? read_cycles() : 0;
 
-            // Calculate the duration and add it to the total time
-            total_time += duration(end - start);
+            // Calculate the duration per call
+            double elapsed = duration(end - start);
+            samples.push_back(elapsed / static_cast<double>(batch));
+            if (config.use_tsc)
+                cycles.push_back(static_cast<double>(end_cycles - start_cycles) / static_cast<double>(batch));
         }
 
+        events.stop();
+        std::array<long, 3> usage_after = detail::resource_usage();
+
+        result summary = detail::summarise(description, samples, batch, cycles);
+        if (config.counters)
+        {
+            summary.counters = events.read(static_cast<double>(runs * batch));
+            if (usage_after[0] >= 0)
+            {
+                summary.minor_faults = usage_after[0] - usage_before[0];
+                summary.major_faults = usage_after[1] - usage_before[1];
+                summary.peak_rss_kb = usage_after[2];
+            }
+        }
+        results().push_back(summary);
+
         // Output benchmark results
-        std::cout << "Benching: " << description << std::endl;
-        std::cout << "Total runs: " << runs << std::endl;
-        std::cout << "Total time taken: " << total_time << "ns" << std::endl;
+        if (config.verbose)
+        {
+            std::cout << "Benching: " << description << std::endl;
+            std::cout << "Total runs: " << runs << " (" << batch << " call" << (batch > 1 ? "s" : "") << " each)" << std::endl;
+            std::cout << "Total time taken: " << summary.total_ns << "ns" << std::endl;
+            std::cout << "Min / median / p99 per run: " << summary.min_ns << "ns / " << summary.median_ns << "ns / "
+                      << summary.p99_ns << "ns (stddev " << summary.stddev_ns << "ns)" << std::endl;
+            if (config.use_tsc)
+                std::cout << "Median cycles per run: " << summary.median_cycles << std::endl;
+            if (config.counters)
+            {
+                if (events.any())
+                {
+                    std::cout << "Counters per run:";
+                    for (std::size_t i = 0; i < counter_count; ++i)
+                    {
+                        if (summary.counters[i] >= 0)
+                            std::cout << " " << counter_names[i] << " " << summary.counters[i];
+                    }
+                    std::cout << std::endl;
+                }
+                std::cout << "Page faults: " << summary.minor_faults << " minor, " << summary.major_faults
+                          << " major (peak RSS " << summary.peak_rss_kb << "KB)" << std::endl;
+            }
+        }
 
-        // Calculate and output the average time per run
-        double average_time = total_time / static_cast<double>(runs);
-        return average_time;
+        // Return the average time per run
+        return summary.mean_ns;
     }
 } // namespace benchmark
@@ -1,20 +1,1078 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <new>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Lets an empty Stats policy share its address with the next member, so stats::none adds no bytes to an arena
+// The attribute is standard from C++20, GCC and Clang also honour it in C++17 and MSVC only in its own spelling
+#if defined(_MSC_VER) && !defined(__clang__)
+#define BUMP_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#elif defined(__has_cpp_attribute)
+#if __has_cpp_attribute(no_unique_address)
+#define BUMP_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+#endif
+#ifndef BUMP_NO_UNIQUE_ADDRESS
+#define BUMP_NO_UNIQUE_ADDRESS
+#endif
 
 namespace bump
 {
     typedef char byte;
 
-    // Templated class for a bump_up allocator
-    template <std::size_t S>
-    class bump_up
+    // Growth policies selecting what happens when the pool runs out
+    namespace growth
+    {
+        // Single pool of S bytes, allocate returns nullptr once it is exhausted
+        struct fixed
+        {
+        };
+
+        // Chain further chunks when the current one is exhausted
+        // Each chunk doubles the size of the previous one, up to Cap bytes
+        template <std::size_t Cap = (std::size_t(1) << 26)>
+        struct geometric
+        {
+            static constexpr std::size_t cap = Cap;
+        };
+
+        template <class G>
+        struct is_chained : std::false_type
+        {
+        };
+
+        template <std::size_t Cap>
+        struct is_chained<geometric<Cap>> : std::true_type
+        {
+        };
+
+        // Commit more of a reserved pool (backing::reserved) Granule bytes at a time as next reaches the committed end
+        // The pool never moves or chains, S is the size of the reservation. Only supported by bump_up.
+        template <std::size_t Granule = (std::size_t(1) << 20)>
+        struct committed
+        {
+            static_assert(Granule > 0 && Granule % 4096 == 0, "Invalid. Granule must be a whole number of pages.");
+            static constexpr std::size_t granule = Granule;
+        };
+
+        template <class G>
+        struct is_committed : std::false_type
+        {
+        };
+
+        template <std::size_t Granule>
+        struct is_committed<committed<Granule>> : std::true_type
+        {
+        };
+    } // namespace growth
+
+    // Backing stores the pool of bump_up and bump_down is obtained from
+    namespace backing
+    {
+        // Pool from new byte[], committed lazily by the kernel 4KB page at a time
+        // Only guarantees __STDCPP_DEFAULT_NEW_ALIGNMENT__ for the start of the pool
+        struct heap
+        {
+            static constexpr std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+            static byte *acquire(std::size_t size) { return new byte[size]; }
+            static void release(byte *pool, std::size_t) { delete[] pool; }
+        };
+
+        // Pool from aligned operator new, starting on an Align byte boundary (e.g. 64 for cache lines and AVX-512)
+        // Allocations aligned to at most Align then never need padding in front of the first one
+        template <std::size_t Align>
+        struct aligned_heap
+        {
+            static_assert((Align & (Align - 1)) == 0, "Invalid. Alignment must be a power of two.");
+            static constexpr std::size_t alignment = Align;
+
+            static byte *acquire(std::size_t size)
+            {
+                return static_cast<byte *>(::operator new[](size, std::align_val_t(Align)));
+            }
+
+            static void release(byte *pool, std::size_t) { ::operator delete[](pool, std::align_val_t(Align)); }
+        };
+
+        // Page sizes a mapped pool can ask for
+        enum class pages
+        {
+            normal,           // Regular pages
+            transparent_huge, // madvise(MADV_HUGEPAGE) on a huge page aligned range
+            explicit_huge     // MAP_HUGETLB from the reserved huge page pool, falling back to normal pages
+        };
+
+        // Pool from an anonymous mmap, optionally backed by huge pages and pre-faulted at construction
+        // Pre-faulting moves the page fault cost out of the first allocations into the constructor,
+        // huge page options round the mapping up to a whole number of 2MB pages
+        template <pages Pages = pages::transparent_huge, bool Prefault = false>
+        struct mapped
+        {
+            static constexpr std::size_t huge_page = std::size_t(2) << 20;
+
+            // Mappings always start on a page boundary
+            static constexpr std::size_t alignment = 4096;
+
+            static byte *acquire(std::size_t size)
+            {
+#if defined(__unix__) || defined(__APPLE__)
+                std::size_t length = mapping_length(size);
+                int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+                void *mapping = MAP_FAILED;
+                bool populated = false;
+
+#ifdef MAP_HUGETLB
+                // Fails when no huge pages are reserved, in which case normal pages are used instead
+                if (Pages == pages::explicit_huge)
+                {
+                    mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB | populate_flag(), -1, 0);
+                    populated = mapping != MAP_FAILED && populate_flag() != 0;
+                }
+#endif
+                // Populated by touching below, after the range has been advised to use huge pages
+                if (mapping == MAP_FAILED && Pages == pages::transparent_huge && length >= huge_page)
+                    mapping = map_huge_aligned(length, flags);
+
+                if (mapping == MAP_FAILED)
+                {
+                    mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags | populate_flag(), -1, 0);
+                    populated = populate_flag() != 0;
+                }
+                if (mapping == MAP_FAILED)
+                    throw std::bad_alloc();
+
+                byte *pool = static_cast<byte *>(mapping);
+
+                // Touch one byte per page when the kernel has not populated the mapping itself
+                if (Prefault && !populated)
+                {
+                    std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+                    for (std::size_t offset = 0; offset < length; offset += page)
+                        pool[offset] = 0;
+                }
+                return pool;
+#else
+                return heap::acquire(size);
+#endif
+            }
+
+            static void release(byte *pool, std::size_t size)
+            {
+#if defined(__unix__) || defined(__APPLE__)
+                munmap(pool, mapping_length(size));
+#else
+                heap::release(pool, size);
+#endif
+            }
+
+        private:
+#ifdef MAP_POPULATE
+            static int populate_flag() { return Prefault ? MAP_POPULATE : 0; }
+#else
+            static int populate_flag() { return 0; }
+#endif
+
+            // Huge page mappings must be released with the same huge page rounded length they were created with
+            static std::size_t mapping_length(std::size_t size)
+            {
+                if (Pages == pages::normal)
+                    return size;
+                return (size + huge_page - 1) & ~(huge_page - 1);
+            }
+
+#if defined(__unix__) || defined(__APPLE__)
+            // Map length bytes starting on a huge page boundary, so the kernel can back all of it with huge pages
+            static void *map_huge_aligned(std::size_t length, int flags)
+            {
+                void *mapping = mmap(nullptr, length + huge_page, PROT_READ | PROT_WRITE, flags, -1, 0);
+                if (mapping == MAP_FAILED)
+                    return MAP_FAILED;
+
+                // Trim the unaligned head and the leftover tail of the over-sized mapping
+                std::uintptr_t raw = reinterpret_cast<std::uintptr_t>(mapping);
+                std::uintptr_t aligned = (raw + huge_page - 1) & ~(huge_page - 1);
+                if (aligned > raw)
+                    munmap(mapping, aligned - raw);
+                if (raw + huge_page > aligned)
+                    munmap(reinterpret_cast<void *>(aligned + length), raw + huge_page - aligned);
+
+#ifdef MADV_HUGEPAGE
+                madvise(reinterpret_cast<void *>(aligned), length, MADV_HUGEPAGE);
+#endif
+                return reinterpret_cast<void *>(aligned);
+            }
+#endif
+        };
+
+        // Address range reserved with mmap(PROT_NONE), so a pool of many GB costs no memory until it is committed
+        // Used with growth::committed, which makes the pages readable and writable as the pool fills up
+        struct reserved
+        {
+            // Mappings always start on a page boundary
+            static constexpr std::size_t alignment = 4096;
+
+            static byte *acquire(std::size_t size)
+            {
+#if defined(__unix__) || defined(__APPLE__)
+                int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+                flags |= MAP_NORESERVE;
+#endif
+                void *mapping = mmap(nullptr, size, PROT_NONE, flags, -1, 0);
+                if (mapping == MAP_FAILED)
+                    throw std::bad_alloc();
+                return static_cast<byte *>(mapping);
+#else
+                return heap::acquire(size);
+#endif
+            }
+
+            static void release(byte *pool, std::size_t size)
+            {
+#if defined(__unix__) || defined(__APPLE__)
+                munmap(pool, size);
+#else
+                heap::release(pool, size);
+#endif
+            }
+
+            // Make [begin, begin + size) usable, begin must be page aligned. False if the kernel refuses
+            static bool commit(byte *begin, std::size_t size)
+            {
+#if defined(__unix__) || defined(__APPLE__)
+                return mprotect(begin, size, PROT_READ | PROT_WRITE) == 0;
+#else
+                (void)begin;
+                (void)size;
+                return true;
+#endif
+            }
+
+            // Drop the pages of [begin, begin + size) and make the range inaccessible again, begin must be page aligned
+            static void decommit(byte *begin, std::size_t size)
+            {
+#if defined(__unix__) || defined(__APPLE__)
+                madvise(begin, size, MADV_DONTNEED);
+                mprotect(begin, size, PROT_NONE);
+#else
+                (void)begin;
+                (void)size;
+#endif
+            }
+        };
+
+        template <class B>
+        struct is_reserved : std::false_type
+        {
+        };
+
+        template <>
+        struct is_reserved<reserved> : std::true_type
+        {
+        };
+    } // namespace backing
+
+    // Statistics policies recording how an arena is used, so it can be sized from data rather than guesswork
+    namespace stats
+    {
+        // Figures reported by statistics()
+        struct snapshot
+        {
+            std::size_t allocations;     // Successful allocation calls (a whole allocate_many batch counts once)
+            std::size_t bytes_requested; // Bytes asked for by those calls, including in-place extensions
+            std::size_t padding_bytes;   // Bytes skipped to satisfy alignment
+            std::size_t failures;        // Allocation calls that returned nullptr because the arena was full
+            std::size_t resets;          // reset() calls
+            std::size_t used;            // Bytes of the arena in use now, counting every chained chunk in full
+            std::size_t high_water;      // Largest value of used seen, across resets and rewinds
+        };
+
+        // Records nothing, every hook is empty so the allocation paths compile exactly as without statistics
+        struct none
+        {
+            static constexpr bool enabled = false;
+
+            void allocated(std::size_t, std::size_t) {}
+            void extended(std::size_t) {}
+            void failed() {}
+            void settle(std::size_t) {}
+            void reset() {}
+        };
+
+        // Plain counters, for arenas owned by a single thread
+        struct counting
+        {
+            static constexpr bool enabled = true;
+
+            void allocated(std::size_t requested, std::size_t padding)
+            {
+                ++data.allocations;
+                data.bytes_requested += requested;
+                data.padding_bytes += padding;
+            }
+
+            void extended(std::size_t requested) { data.bytes_requested += requested; }
+            void failed() { ++data.failures; }
+
+            // Usage only grows between the points where memory is given back, so sampling it there finds the peak
+            void settle(std::size_t used) { data.high_water = std::max(data.high_water, used); }
+            void reset() { ++data.resets; }
+
+            snapshot read(std::size_t used) const
+            {
+                snapshot current = data;
+                current.used = used;
+                current.high_water = std::max(current.high_water, used);
+                return current;
+            }
+
+        private:
+            snapshot data{};
+        };
+    } // namespace stats
+
+    // Page release policies applied by reset() to the part of the pool beyond the retained bytes
+    enum class release
+    {
+        keep,      // Keep every page resident (plain rewind, chained chunks are kept)
+        dont_need, // madvise(MADV_DONTNEED): pages are dropped immediately and read back as zero
+        lazy_free  // madvise(MADV_FREE): the kernel reclaims pages only under memory pressure
+    };
+
+    namespace detail
+    {
+        struct chunk;
+        struct destructor;
+    } // namespace detail
+
+    // Saved allocation position that an allocator can later be rewound to
+    struct checkpoint
+    {
+        byte *next;
+        detail::chunk *chunk;            // Chained chunk next points into, nullptr for the pool itself
+        detail::destructor *destructors; // Most recent destructor record when the checkpoint was taken
+    };
+
+    namespace detail
+    {
+        // Header placed in front of every chained chunk, linking it to the previously used chunk
+        struct chunk
+        {
+            chunk *prev;
+            std::size_t size;
+
+            byte *begin() { return reinterpret_cast<byte *>(this + 1); }
+            byte *end() { return begin() + size; }
+        };
+
+        // Allocate a chunk able to hold size bytes and link it in front of prev
+        inline chunk *new_chunk(std::size_t size, chunk *prev)
+        {
+            byte *raw = new byte[sizeof(chunk) + size];
+            return new (raw) chunk{prev, size};
+        }
+
+        // Release every chunk in the list starting at head
+        inline void free_chunks(chunk *&head)
+        {
+            while (head)
+            {
+                chunk *prev = head->prev;
+                delete[] reinterpret_cast<byte *>(head);
+                head = prev;
+            }
+        }
+
+        // Take a recycled chunk of at least bytes_needed from spare, or allocate a new one of size bytes
+        inline chunk *take_chunk(chunk *&spare, std::size_t size, std::size_t bytes_needed, chunk *prev)
+        {
+            if (spare && spare->size >= bytes_needed)
+            {
+                chunk *c = spare;
+                spare = spare->prev;
+                c->prev = prev;
+                return c;
+            }
+            return new_chunk(size, prev);
+        }
+
+        // Move the chunks in use newer than stop onto the spare list, oldest first so they are reused in the same order
+        inline void recycle_chunks(chunk *&head, chunk *&spare, chunk *stop = nullptr)
+        {
+            while (head != stop)
+            {
+                chunk *prev = head->prev;
+                head->prev = spare;
+                spare = head;
+                head = prev;
+            }
+        }
+
+        // Hand the whole pages inside [begin, end) back to the kernel according to policy
+        inline void release_pages(byte *begin, byte *end, release policy)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            std::uintptr_t page_mask = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE)) - 1;
+
+            // Round inwards so pages shared with live data or heap metadata are never touched
+            std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(begin) + page_mask) & ~page_mask;
+            std::uintptr_t last = reinterpret_cast<std::uintptr_t>(end) & ~page_mask;
+            if (policy == release::keep || first >= last)
+                return;
+
+#ifdef MADV_FREE
+            int advice = policy == release::lazy_free ? MADV_FREE : MADV_DONTNEED;
+#else
+            int advice = MADV_DONTNEED;
+#endif
+            madvise(reinterpret_cast<void *>(first), last - first, advice);
+#else
+            (void)begin;
+            (void)end;
+            (void)policy;
+#endif
+        }
+
+        // Total size of the chunk at head and every older chunk in its list
+        inline std::size_t chained_bytes(const chunk *head)
+        {
+            std::size_t total = 0;
+            for (; head; head = head->prev)
+                total += head->size;
+            return total;
+        }
+
+        // Size of the chunk that follows one of last_size bytes, large enough for bytes_needed
+        template <class Growth>
+        std::size_t next_chunk_size(std::size_t last_size, std::size_t bytes_needed)
+        {
+            std::size_t size = std::min(last_size * 2, Growth::cap);
+            return std::max(size, bytes_needed);
+        }
+
+        // Record of objects with a non-trivial destructor, allocated in the arena alongside them
+        struct destructor
+        {
+            destructor *prev;
+            void (*destroy)(void *object, std::size_t count);
+            void *object;
+            std::size_t count;
+        };
+
+        // Destroy count objects of type T in reverse order of construction
+        template <class T>
+        void destroy_array(void *object, std::size_t count)
+        {
+            T *objects = static_cast<T *>(object);
+            for (std::size_t i = count; i > 0; --i)
+                objects[i - 1].~T();
+        }
+
+        // Run and unlink the destructor records newer than stop, most recent first
+        inline void run_destructors(destructor *&head, destructor *stop = nullptr)
+        {
+            while (head != stop)
+            {
+                head->destroy(head->object, head->count);
+                head = head->prev;
+            }
+        }
+
+        // Placement-construct a T, using braces for aggregates that have no matching constructor
+        template <class T, class... Args>
+        void construct(T *object, Args &&...args)
+        {
+            if constexpr (std::is_constructible_v<T, Args...>)
+                new (object) T(std::forward<Args>(args)...);
+            else
+                new (object) T{std::forward<Args>(args)...};
+        }
+
+        // Construct n objects of type T in arena, each from args
+        // A destructor record is only allocated and linked into head when T is not trivially destructible,
+        // so plain data keeps the cost of allocate<T>(n). Returns nullptr if the arena is exhausted.
+        template <class T, class Arena, class... Args>
+        T *make_array(Arena &arena, destructor *&head, std::size_t n, const Args &...args)
+        {
+            constexpr bool tracked = !std::is_trivially_destructible_v<T>;
+
+            destructor *record = nullptr;
+            if constexpr (tracked)
+            {
+                record = arena.template allocate<destructor>(1);
+                if (record == nullptr)
+                    return nullptr;
+            }
+
+            T *objects = arena.template allocate<T>(n);
+            if (objects == nullptr)
+                return nullptr;
+
+            // Objects already built are destroyed again if a later constructor throws
+            std::size_t built = 0;
+            try
+            {
+                for (; built < n; ++built)
+                    construct(objects + built, args...);
+            }
+            catch (...)
+            {
+                destroy_array<T>(objects, built);
+                throw;
+            }
+
+            if constexpr (tracked)
+            {
+                *record = destructor{head, destroy_array<T>, objects, n};
+                head = record;
+            }
+            return objects;
+        }
+
+        // Construct a single T in arena from args, see make_array
+        template <class T, class Arena, class... Args>
+        T *make(Arena &arena, destructor *&head, Args &&...args)
+        {
+            constexpr bool tracked = !std::is_trivially_destructible_v<T>;
+
+            destructor *record = nullptr;
+            if constexpr (tracked)
+            {
+                record = arena.template allocate<destructor>(1);
+                if (record == nullptr)
+                    return nullptr;
+            }
+
+            T *object = arena.template allocate<T>(1);
+            if (object == nullptr)
+                return nullptr;
+            construct(object, std::forward<Args>(args)...);
+
+            if constexpr (tracked)
+            {
+                *record = destructor{head, destroy_array<T>, object, 1};
+                head = record;
+            }
+            return object;
+        }
+
+        // One count per type in an allocate_many pack
+        template <class T>
+        using count_t = std::size_t;
+
+        // Place n objects of type T at the next aligned address at or above cursor and move cursor past them
+        // Returns 0 (and leaves cursor alone) for an empty array, like allocate<T>(0)
+        template <class T>
+        std::uintptr_t place_up(std::uintptr_t &cursor, std::size_t n)
+        {
+            if (n < 1)
+                return 0;
+            std::uintptr_t start = (cursor + alignof(T) - 1) & ~std::uintptr_t(alignof(T) - 1);
+            cursor = start + sizeof(T) * n;
+            return start;
+        }
+
+        // Place n objects of type T at the next aligned address below cursor and move cursor down to them
+        template <class T>
+        std::uintptr_t place_down(std::uintptr_t &cursor, std::size_t n)
+        {
+            if (n < 1)
+                return 0;
+            cursor = (cursor - sizeof(T) * n) & ~std::uintptr_t(alignof(T) - 1);
+            return cursor;
+        }
+
+        // Bytes a batch can need in the worst case, wherever it starts
+        template <class... Ts>
+        std::size_t batch_bytes(count_t<Ts>... n)
+        {
+            return (std::size_t(0) + ... + (sizeof(Ts) * n + alignof(Ts) - 1));
+        }
+
+        // Turn the placed addresses of a batch into a tuple of typed pointers
+        template <class... Ts, std::size_t... I>
+        std::tuple<Ts *...> typed_tuple(const std::uintptr_t *addresses, std::index_sequence<I...>)
+        {
+            return std::tuple<Ts *...>(reinterpret_cast<Ts *>(addresses[I])...);
+        }
+    } // namespace detail
+
+    // Templated class for a bump_up allocator
+    // Quantum > 1 rounds every allocation size up to a multiple of Quantum, keeping next Quantum aligned at all times,
+    // so allocate<T> skips the alignment rounding for every T with alignof(T) <= Quantum
+    template <std::size_t S, class Growth = growth::fixed, class Backing = backing::heap, class Stats = stats::none,
+              std::size_t Quantum = 1>
+    class bump_up
+    {
+        static constexpr bool chained = growth::is_chained<Growth>::value;
+        static constexpr bool committing = growth::is_committed<Growth>::value;
+
+        static_assert(committing == backing::is_reserved<Backing>::value, "Invalid. growth::committed and backing::reserved must be used together.");
+        static_assert((Quantum & (Quantum - 1)) == 0, "Invalid. Quantum must be a power of two.");
+        static_assert(Quantum <= Backing::alignment, "Invalid. Quantum cannot exceed the alignment of the pool.");
+        static_assert(!chained || Quantum <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Invalid. Quantum cannot exceed the alignment of chained chunks.");
+
+    public:
+        // Alignment the start of the pool is guaranteed to have, set by the backing store
+        static constexpr std::size_t base_alignment = Backing::alignment;
+
+        // Alignment next is guaranteed to have between allocations
+        static constexpr std::size_t cursor_alignment = Quantum;
+
+        // Constructor
+        bump_up()
+        {
+            // Check if size is valid
+            if (S < 1)
+            {
+                throw std::invalid_argument("Invalid. Size must be greater than 0.");
+            }
+
+            // Initialize pool size and pointers
+            pool_size = S;
+            pool = Backing::acquire(pool_size);
+            next = pool;
+            limit = pool_end();
+            high_water = pool;
+        }
+
+        // Destructor
+        ~bump_up() { deallocate(); }
+
+        // Allocate memory for type T
+        template <class T>
+        T *allocate(std::size_t n)
+        {
+            // Check if allocation size is valid
+            if (n < 1)
+                return nullptr;
+
+            // Allocate pool if not initialized
+            if (pool == nullptr)
+            {
+                pool = Backing::acquire(pool_size);
+                next = pool;
+                limit = pool_end();
+                high_water = pool;
+            }
+
+            // Calculate required bytes and alignment
+            std::size_t bytes_needed = quantised(sizeof(T) * n);
+            std::size_t alignment = alignof(T);
+
+            // Convert the next pointer to an unsigned integer representing the raw memory address
+            std::uintptr_t raw_address = reinterpret_cast<std::uintptr_t>(next);
+
+            // Calculate a mask to isolate the least significant bits that need adjustment for alignment
+            // The mask is created by taking the value of alignment and subtracting 1
+            std::uintptr_t mask = alignment - 1;
+
+            // Calculate the aligned address by adding the mask to the raw address, rounding up
+            // Then, apply a bitwise AND with the complement of the mask to clear the unnecessary bits
+            // Skipped at compile time when next is already known to be aligned enough for T
+            std::uintptr_t aligned_address = raw_address;
+            if constexpr (alignof(T) > Quantum)
+                aligned_address = (raw_address + mask) & ~mask;
+
+            // Check if allocation exceeds the current chunk, chaining a new one if growth is enabled
+            // Worst case padding is alignment - 1 bytes, after growing the allocation is guaranteed to fit
+            if (reinterpret_cast<byte *>(aligned_address + bytes_needed) > limit)
+                return grow(grow_size(aligned_address + bytes_needed, bytes_needed + mask)) ? allocate<T>(n) : failed<T *>();
+
+            // Update next pointer and return the aligned address
+            tally.allocated(sizeof(T) * n, aligned_address - raw_address + bytes_needed - sizeof(T) * n);
+            next = reinterpret_cast<byte *>(aligned_address + bytes_needed);
+            return reinterpret_cast<T *>(aligned_address);
+        }
+
+        // Allocate size bytes aligned to alignment, which must be a power of two
+        // Used by type-erased callers such as memory resources
+        void *allocate_bytes(std::size_t size, std::size_t alignment)
+        {
+            if (size < 1)
+                return nullptr;
+
+            if (pool == nullptr)
+            {
+                pool = Backing::acquire(pool_size);
+                next = pool;
+                limit = pool_end();
+                high_water = pool;
+            }
+
+            std::size_t bytes_needed = quantised(size);
+            std::uintptr_t mask = alignment - 1;
+            std::uintptr_t aligned_address = (reinterpret_cast<std::uintptr_t>(next) + mask) & ~mask;
+
+            if (reinterpret_cast<byte *>(aligned_address + bytes_needed) > limit)
+                return grow(grow_size(aligned_address + bytes_needed, bytes_needed + mask)) ? allocate_bytes(size, alignment) : failed<void *>();
+
+            tally.allocated(size, aligned_address - reinterpret_cast<std::uintptr_t>(next) + bytes_needed - size);
+            next = reinterpret_cast<byte *>(aligned_address + bytes_needed);
+            return reinterpret_cast<void *>(aligned_address);
+        }
+
+        // Allocate n objects of type T aligned to alignment (a power of two), or alignof(T) if that is stricter
+        // e.g. allocate_aligned<float>(n, 64) for cache line or AVX-512 aligned buffers
+        template <class T>
+        T *allocate_aligned(std::size_t n, std::size_t alignment)
+        {
+            return static_cast<T *>(allocate_bytes(sizeof(T) * n, std::max(alignment, alignof(T))));
+        }
+
+        // Grow the array at ptr from old_n to new_n objects in place, only possible while it is the most recent allocation
+        // Returns false (and changes nothing) if something was allocated after it or the pool has no room left
+        template <class T>
+        bool try_extend(T *ptr, std::size_t old_n, std::size_t new_n)
+        {
+            if (ptr == nullptr || end_of(ptr, old_n) != next || new_n < old_n)
+                return false;
+            if (new_n - old_n > static_cast<std::size_t>(reserved_end() - next) / sizeof(T))
+                return false;
+            if constexpr (Quantum > 1 || committing)
+            {
+                // Rounding the new size up can still cross the end of the chunk, a reservation commits more instead
+                if (end_of(ptr, new_n) > limit && (!committing || !grow(end_of(ptr, new_n) - next)))
+                    return false;
+            }
+
+            tally.extended(sizeof(T) * (new_n - old_n));
+            next = end_of(ptr, new_n);
+            return true;
+        }
+
+        // Give back the tail of the array at ptr beyond new_n objects, only possible while it is the most recent allocation
+        template <class T>
+        bool shrink(T *ptr, std::size_t old_n, std::size_t new_n)
+        {
+            if (ptr == nullptr || end_of(ptr, old_n) != next || new_n > old_n)
+                return false;
+
+            // Record how far the pool was touched before moving next back, as rewind() does
+            settle();
+            if (!chunks)
+                high_water = std::max(high_water, next);
+            next = end_of(ptr, new_n);
+            return true;
+        }
+
+        // Resize the array at ptr to new_n objects, like realloc
+        // Adjusts next in place when ptr is the most recent allocation and only copies into a new block otherwise
+        template <class T>
+        T *reallocate(T *ptr, std::size_t old_n, std::size_t new_n)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Invalid. reallocate copies objects bytewise.");
+
+            if (ptr == nullptr)
+                return allocate<T>(new_n);
+            if (new_n <= old_n)
+            {
+                shrink(ptr, old_n, new_n);
+                return ptr;
+            }
+            if (try_extend(ptr, old_n, new_n))
+                return ptr;
+
+            T *moved = allocate<T>(new_n);
+            if (moved != nullptr)
+                std::memcpy(moved, ptr, sizeof(T) * old_n);
+            return moved;
+        }
+
+        // Allocate one array of each type Ts with the matching count in n, e.g. allocate_many<int, double>(100, 50)
+        // The layout is computed up front so the whole batch costs one capacity check and one pointer bump.
+        // Either every array is allocated or the result is all nullptr (arrays with a count of 0 are always nullptr).
+        template <class... Ts>
+        std::tuple<Ts *...> allocate_many(detail::count_t<Ts>... n)
+        {
+            // Allocate pool if not initialized
+            if (pool == nullptr)
+            {
+                pool = Backing::acquire(pool_size);
+                next = pool;
+                limit = pool_end();
+                high_water = pool;
+            }
+
+            // Braced initialisation places the arrays in order, one after another
+            std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(next);
+            std::uintptr_t addresses[] = {detail::place_up<Ts>(cursor, n)...};
+            cursor = quantised(cursor);
+
+            // Check if the whole batch fits in the current chunk, chaining a new one if growth is enabled
+            if (reinterpret_cast<byte *>(cursor) > limit)
+                return grow(grow_size(cursor, detail::batch_bytes<Ts...>(n...) + Quantum - 1)) ? allocate_many<Ts...>(n...) : failed<std::tuple<Ts *...>>();
+
+            std::size_t requested = (std::size_t(0) + ... + (sizeof(Ts) * n));
+            tally.allocated(requested, cursor - reinterpret_cast<std::uintptr_t>(next) - requested);
+            next = reinterpret_cast<byte *>(cursor);
+            return detail::typed_tuple<Ts...>(addresses, std::index_sequence_for<Ts...>());
+        }
+
+        // Construct a T from args in the arena, its destructor runs on reset(), deallocate() or destruction
+        // Only types that are not trivially destructible cost a destructor record
+        template <class T, class... Args>
+        T *make(Args &&...args)
+        {
+            return detail::make<T>(*this, destructors, std::forward<Args>(args)...);
+        }
+
+        // Construct n objects of type T, each from args, see make()
+        template <class T, class... Args>
+        T *make_array(std::size_t n, const Args &...args)
+        {
+            return detail::make_array<T>(*this, destructors, n, args...);
+        }
+
+        // Deallocate memory, releasing the pool and every chained chunk
+        void deallocate()
+        {
+            settle();
+            detail::run_destructors(destructors);
+            detail::free_chunks(chunks);
+            detail::free_chunks(spare);
+            if (pool)
+            {
+                Backing::release(pool, pool_size);
+                pool = nullptr;
+                next = nullptr;
+                limit = nullptr;
+                high_water = nullptr;
+                committed = 0;
+            }
+        }
+
+        // Rewind next to the start of the pool while keeping its memory
+        // With release::keep chained chunks are moved to the spare list for reuse, which walks the chain, so the
+        // cost is O(chunks) plus one call per registered destructor (O(1) for a single pool without destructors),
+        // otherwise they are freed and pool pages between retain bytes and the high-water mark are released
+        // (a reserved pool decommits every granule beyond retain bytes instead)
+        void reset(release policy = release::keep, std::size_t retain = 0)
+        {
+            if (pool == nullptr)
+                return;
+
+            settle();
+            tally.reset();
+            detail::run_destructors(destructors);
+            if (!chunks)
+                high_water = std::max(high_water, next);
+
+            if (policy == release::keep)
+            {
+                detail::recycle_chunks(chunks, spare);
+            }
+            else
+            {
+                detail::free_chunks(chunks);
+                detail::free_chunks(spare);
+
+                byte *retained_end = pool + std::min(retain, pool_size);
+                if constexpr (committing)
+                {
+                    // Decommit whole granules beyond retain bytes, the pages are dropped whatever the policy
+                    std::size_t kept = std::min(granules(retain), committed);
+                    Backing::decommit(pool + kept, committed - kept);
+                    committed = kept;
+                }
+                else if (high_water > retained_end)
+                {
+                    detail::release_pages(retained_end, high_water, policy);
+                    high_water = retained_end;
+                }
+            }
+
+            next = pool;
+            limit = pool_end();
+        }
+
+        // Current allocation position, to be passed to rewind()
+        checkpoint marker() const { return checkpoint{next, chunks, destructors}; }
+
+        // Release everything allocated since m was taken, keeping the memory hot for the next allocations
+        // Checkpoints must be rewound in LIFO order and are invalidated by reset() and deallocate()
+        void rewind(const checkpoint &m)
+        {
+            settle();
+            detail::run_destructors(destructors, m.destructors);
+            if (!chunks)
+                high_water = std::max(high_water, next);
+
+            detail::recycle_chunks(chunks, spare, m.chunk);
+            next = m.next;
+            limit = chunks ? chunks->end() : pool_end();
+        }
+
+        // Usage figures recorded by the Stats policy, all zero with stats::none
+        stats::snapshot statistics() const
+        {
+            if constexpr (Stats::enabled)
+                return tally.read(used_bytes());
+            else
+                return stats::snapshot{};
+        }
+
+        // Bytes of the pool that can be written, less than the reservation for growth::committed
+        std::size_t committed_bytes() const { return pool ? pool_end() - pool : 0; }
+
+        // Print the next address in the pool
+        void print_next_addr() const
+        {
+            std::cout << "Address: " << reinterpret_cast<std::uintptr_t>(next) << std::endl;
+        }
+
+    private:
+        // Size rounded up to a whole number of quanta, so next keeps Quantum alignment
+        static constexpr std::size_t quantised(std::size_t size) { return (size + Quantum - 1) & ~(Quantum - 1); }
+
+        // End of an array of n objects of type T starting at ptr, including the rounding to Quantum
+        template <class T>
+        static byte *end_of(T *ptr, std::size_t n) { return reinterpret_cast<byte *>(ptr) + quantised(sizeof(T) * n); }
+
+        // End of the part of the pool that can be allocated from, only the committed part of a reservation
+        byte *pool_end() const { return pool + (committing ? committed : pool_size); }
+
+        // End of the memory next could reach without chaining
+        byte *reserved_end() const { return committing ? pool + pool_size : limit; }
+
+        // Size rounded up to whole commit granules, capped at the reservation
+        static std::size_t granules(std::size_t size)
+        {
+            if constexpr (committing)
+                return std::min(size + (Growth::granule - size % Growth::granule) % Growth::granule, S);
+            else
+                return size;
+        }
+
+        // Size to pass to grow() for an allocation ending at end that did not fit
+        // A reservation never moves, so the aligned end is exact, a new chunk needs room for the worst case padding
+        std::size_t grow_size(std::uintptr_t end, std::size_t worst_case) const
+        {
+            if constexpr (committing)
+                return end - reinterpret_cast<std::uintptr_t>(next);
+            else
+                return worst_case;
+        }
+
+        // Record a failed allocation and return R's empty value
+        template <class R>
+        R failed()
+        {
+            tally.failed();
+            return R();
+        }
+
+        // Bytes in use, with every chunk before the current one counted in full
+        std::size_t used_bytes() const
+        {
+            if (pool == nullptr)
+                return 0;
+            if (!chunks)
+                return next - pool;
+            return pool_size + detail::chained_bytes(chunks->prev) + (next - chunks->begin());
+        }
+
+        // Sample usage for the high-water mark before memory is given back, only when statistics are enabled
+        void settle()
+        {
+            if constexpr (Stats::enabled)
+                tally.settle(used_bytes());
+        }
+
+        // Slow path taken when the current chunk is exhausted
+        // Chains a chunk able to hold bytes_needed (including worst case alignment padding), false if growth is disabled
+        // A reservation instead commits up to next + bytes_needed, the exact aligned end from grow_size()
+        bool grow(std::size_t bytes_needed)
+        {
+            if constexpr (committing)
+            {
+                // Commit the granules between the committed end and next + bytes_needed, unless that leaves the reservation
+                std::size_t offset = next - pool;
+                if (bytes_needed > pool_size - offset)
+                    return false;
+
+                std::size_t target = granules(offset + bytes_needed);
+                if (!Backing::commit(pool + committed, target - committed))
+                    return false;
+                committed = target;
+                limit = pool_end();
+                return true;
+            }
+            else if constexpr (!chained)
+            {
+                (void)bytes_needed;
+                return false;
+            }
+            else
+            {
+                std::size_t last_size = chunks ? chunks->size : pool_size;
+
+                // Leaving the pool for the first time, so all of it may have been touched
+                if (!chunks)
+                    high_water = limit;
+
+                std::size_t size = detail::next_chunk_size<Growth>(last_size, bytes_needed);
+                chunks = detail::take_chunk(spare, size, bytes_needed, chunks);
+                next = chunks->begin();
+                limit = chunks->end();
+                return true;
+            }
+        }
+
+        // Private members
+        byte *pool;
+        byte *next;
+        byte *limit;
+        byte *high_water = nullptr; // Furthest address touched in the pool since pages were last released
+        std::size_t pool_size;
+        std::size_t committed = 0; // Bytes of a reserved pool that are readable and writable
+        detail::chunk *chunks = nullptr;
+        detail::chunk *spare = nullptr;
+        detail::destructor *destructors = nullptr;
+        BUMP_NO_UNIQUE_ADDRESS Stats tally;
+    }; // CLASS bump_up
+
+    // Pool, next, limit, high_water, pool_size, committed, chunks, spare and destructors, with no room for stats::none
+    static_assert(sizeof(bump_up<64>) == 9 * sizeof(void *), "Invalid. stats::none must not add to the size of bump_up.");
+
+    // Templated class for a bump down allocator
+    // Quantum > 1 rounds every allocation size up to a multiple of Quantum, keeping next Quantum aligned at all times,
+    // so allocate<T> skips the alignment rounding for every T with alignof(T) <= Quantum
+    template <std::size_t S, class Growth = growth::fixed, class Backing = backing::heap, class Stats = stats::none,
+              std::size_t Quantum = 1>
+    class bump_down
     {
+        static constexpr bool chained = growth::is_chained<Growth>::value;
+
+        static_assert(!growth::is_committed<Growth>::value && !backing::is_reserved<Backing>::value, "Invalid. Reserved pools are only supported by bump_up.");
+        static_assert((Quantum & (Quantum - 1)) == 0, "Invalid. Quantum must be a power of two.");
+        static_assert(Quantum <= Backing::alignment, "Invalid. Quantum cannot exceed the alignment of the pool.");
+        static_assert(!chained || Quantum <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Invalid. Quantum cannot exceed the alignment of chained chunks.");
+        static_assert(S % Quantum == 0, "Invalid. Size must be a multiple of Quantum so the top of the pool is aligned.");
 
     public:
+        // Alignment the start of the pool is guaranteed to have, set by the backing store
+        static constexpr std::size_t base_alignment = Backing::alignment;
+
+        // Alignment next is guaranteed to have between allocations
+        static constexpr std::size_t cursor_alignment = Quantum;
+
         // Constructor
-        bump_up()
+        bump_down()
         {
             // Check if size is valid
             if (S < 1)
@@ -24,12 +1082,14 @@ namespace bump
 
             // Initialize pool size and pointers
             pool_size = S;
-            pool = new byte[pool_size];
-            next = pool;
+            pool = Backing::acquire(pool_size);
+            next = (pool + pool_size);
+            limit = pool;
+            low_water = next;
         }
 
         // Destructor
-        ~bump_up() { deallocate(); }
+        ~bump_down() { deallocate(); }
 
         // Allocate memory for type T
         template <class T>
@@ -42,43 +1102,200 @@ namespace bump
             // Allocate pool if not initialized
             if (pool == nullptr)
             {
-                pool = new byte[pool_size];
-                next = pool;
+                pool = Backing::acquire(pool_size);
+                next = pool + pool_size;
+                limit = pool;
+                low_water = next;
             }
 
             // Calculate required bytes and alignment
-            std::size_t bytes_needed = sizeof(T) * n;
+            std::size_t bytes_needed = quantised(sizeof(T) * n);
             std::size_t alignment = alignof(T);
 
             // Convert the next pointer to an unsigned integer representing the raw memory address
             std::uintptr_t raw_address = reinterpret_cast<std::uintptr_t>(next);
 
             // Calculate a mask to isolate the least significant bits that need adjustment for alignment
-            // The mask is created by taking the value of alignment and subtracting 1
-            std::uintptr_t mask = alignment - 1;
+            // The mask is created by inverting the bits of (alignment - 1)
+            std::uintptr_t mask = ~(alignment - 1);
 
-            // Calculate the aligned address by adding the mask to the raw address, rounding up
-            // Then, apply a bitwise AND with the complement of the mask to clear the unnecessary bits
-            std::uintptr_t aligned_address = (raw_address + mask) & ~mask;
+            // Calculate the aligned address by subtracting the required bytes and applying the mask
+            // This ensures that the address is adjusted to the nearest lower multiple of the alignment
+            // The mask is skipped at compile time when next and the size already keep T aligned
+            std::uintptr_t aligned_address = raw_address - bytes_needed;
+            if constexpr (alignof(T) > Quantum)
+                aligned_address &= mask;
 
-            // Check if allocation exceeds pool size
-            if (reinterpret_cast<byte *>(aligned_address + bytes_needed) > pool + pool_size)
-                return nullptr;
+            // Check if the aligned address is within the current chunk, chaining a new one if growth is enabled
+            // Worst case padding is alignment - 1 bytes, after growing the allocation is guaranteed to fit
+            if (reinterpret_cast<byte *>(aligned_address) < limit)
+                return grow(bytes_needed + alignment - 1) ? allocate<T>(n) : failed<T *>();
 
             // Update next pointer and return the aligned address
-            next = reinterpret_cast<byte *>(aligned_address + bytes_needed);
+            tally.allocated(sizeof(T) * n, raw_address - aligned_address - sizeof(T) * n);
+            next = reinterpret_cast<byte *>(aligned_address);
             return reinterpret_cast<T *>(aligned_address);
         }
 
-        // Deallocate memory
+        // Allocate size bytes aligned to alignment, which must be a power of two
+        // Used by type-erased callers such as memory resources
+        void *allocate_bytes(std::size_t size, std::size_t alignment)
+        {
+            if (size < 1)
+                return nullptr;
+
+            if (pool == nullptr)
+            {
+                pool = Backing::acquire(pool_size);
+                next = pool + pool_size;
+                limit = pool;
+                low_water = next;
+            }
+
+            std::size_t bytes_needed = quantised(size);
+            std::uintptr_t raw_address = reinterpret_cast<std::uintptr_t>(next);
+            std::uintptr_t aligned_address = (raw_address - bytes_needed) & ~(alignment - 1);
+
+            // Also reject sizes that would wrap below address 0
+            if (bytes_needed > raw_address || reinterpret_cast<byte *>(aligned_address) < limit)
+                return grow(bytes_needed + alignment - 1) ? allocate_bytes(size, alignment) : failed<void *>();
+
+            tally.allocated(size, raw_address - aligned_address - size);
+            next = reinterpret_cast<byte *>(aligned_address);
+            return reinterpret_cast<void *>(aligned_address);
+        }
+
+        // Allocate n objects of type T aligned to alignment (a power of two), or alignof(T) if that is stricter
+        // e.g. allocate_aligned<float>(n, 64) for cache line or AVX-512 aligned buffers
+        template <class T>
+        T *allocate_aligned(std::size_t n, std::size_t alignment)
+        {
+            return static_cast<T *>(allocate_bytes(sizeof(T) * n, std::max(alignment, alignof(T))));
+        }
+
+        // Allocate one array of each type Ts with the matching count in n, e.g. allocate_many<int, double>(100, 50)
+        // The layout is computed up front so the whole batch costs one capacity check and one pointer bump.
+        // Either every array is allocated or the result is all nullptr (arrays with a count of 0 are always nullptr).
+        template <class... Ts>
+        std::tuple<Ts *...> allocate_many(detail::count_t<Ts>... n)
+        {
+            // Allocate pool if not initialized
+            if (pool == nullptr)
+            {
+                pool = Backing::acquire(pool_size);
+                next = pool + pool_size;
+                limit = pool;
+                low_water = next;
+            }
+
+            // Braced initialisation places the arrays in order, each one below the previous
+            std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(next);
+            std::uintptr_t addresses[] = {detail::place_down<Ts>(cursor, n)...};
+            cursor &= ~(Quantum - 1);
+
+            // Check if the whole batch fits in the current chunk (without wrapping below address 0),
+            // chaining a new one if growth is enabled
+            if (reinterpret_cast<byte *>(cursor) < limit || cursor > reinterpret_cast<std::uintptr_t>(next))
+                return grow(detail::batch_bytes<Ts...>(n...) + Quantum - 1) ? allocate_many<Ts...>(n...) : failed<std::tuple<Ts *...>>();
+
+            std::size_t requested = (std::size_t(0) + ... + (sizeof(Ts) * n));
+            tally.allocated(requested, reinterpret_cast<std::uintptr_t>(next) - cursor - requested);
+            next = reinterpret_cast<byte *>(cursor);
+            return detail::typed_tuple<Ts...>(addresses, std::index_sequence_for<Ts...>());
+        }
+
+        // Construct a T from args in the arena, its destructor runs on reset(), deallocate() or destruction
+        // Only types that are not trivially destructible cost a destructor record
+        template <class T, class... Args>
+        T *make(Args &&...args)
+        {
+            return detail::make<T>(*this, destructors, std::forward<Args>(args)...);
+        }
+
+        // Construct n objects of type T, each from args, see make()
+        template <class T, class... Args>
+        T *make_array(std::size_t n, const Args &...args)
+        {
+            return detail::make_array<T>(*this, destructors, n, args...);
+        }
+
+        // Deallocate memory, releasing the pool and every chained chunk
         void deallocate()
         {
+            settle();
+            detail::run_destructors(destructors);
+            detail::free_chunks(chunks);
+            detail::free_chunks(spare);
             if (pool)
             {
-                delete[] pool;
+                Backing::release(pool, pool_size);
                 pool = nullptr;
                 next = nullptr;
+                limit = nullptr;
+                low_water = nullptr;
+            }
+        }
+
+        // Rewind next to the end of the pool while keeping its memory
+        // With release::keep chained chunks are moved to the spare list for reuse, which walks the chain, so the
+        // cost is O(chunks) plus one call per registered destructor (O(1) for a single pool without destructors),
+        // otherwise they are freed and pool pages between the low-water mark and the top retain bytes are released
+        void reset(release policy = release::keep, std::size_t retain = 0)
+        {
+            if (pool == nullptr)
+                return;
+
+            settle();
+            tally.reset();
+            detail::run_destructors(destructors);
+            if (!chunks)
+                low_water = std::min(low_water, next);
+
+            if (policy == release::keep)
+            {
+                detail::recycle_chunks(chunks, spare);
+            }
+            else
+            {
+                detail::free_chunks(chunks);
+                detail::free_chunks(spare);
+
+                byte *retained_begin = pool + pool_size - std::min(retain, pool_size);
+                if (low_water < retained_begin)
+                {
+                    detail::release_pages(low_water, retained_begin, policy);
+                    low_water = retained_begin;
+                }
             }
+
+            next = pool + pool_size;
+            limit = pool;
+        }
+
+        // Current allocation position, to be passed to rewind()
+        checkpoint marker() const { return checkpoint{next, chunks, destructors}; }
+
+        // Release everything allocated since m was taken, keeping the memory hot for the next allocations
+        // Checkpoints must be rewound in LIFO order and are invalidated by reset() and deallocate()
+        void rewind(const checkpoint &m)
+        {
+            settle();
+            detail::run_destructors(destructors, m.destructors);
+            if (!chunks)
+                low_water = std::min(low_water, next);
+
+            detail::recycle_chunks(chunks, spare, m.chunk);
+            next = m.next;
+            limit = chunks ? chunks->begin() : pool;
+        }
+
+        // Usage figures recorded by the Stats policy, all zero with stats::none
+        stats::snapshot statistics() const
+        {
+            if constexpr (Stats::enabled)
+                return tally.read(used_bytes());
+            else
+                return stats::snapshot{};
         }
 
         // Print the next address in the pool
@@ -88,19 +1305,88 @@ namespace bump
         }
 
     private:
+        // Size rounded up to a whole number of quanta, so next keeps Quantum alignment
+        static constexpr std::size_t quantised(std::size_t size) { return (size + Quantum - 1) & ~(Quantum - 1); }
+
+        // Record a failed allocation and return R's empty value
+        template <class R>
+        R failed()
+        {
+            tally.failed();
+            return R();
+        }
+
+        // Bytes in use, with every chunk before the current one counted in full
+        std::size_t used_bytes() const
+        {
+            if (pool == nullptr)
+                return 0;
+            if (!chunks)
+                return pool + pool_size - next;
+            return pool_size + detail::chained_bytes(chunks->prev) + (chunks->end() - next);
+        }
+
+        // Sample usage for the high-water mark before memory is given back, only when statistics are enabled
+        void settle()
+        {
+            if constexpr (Stats::enabled)
+                tally.settle(used_bytes());
+        }
+
+        // Slow path taken when the current chunk is exhausted
+        // Chains a chunk able to hold bytes_needed (including worst case alignment padding), false if growth is disabled
+        bool grow(std::size_t bytes_needed)
+        {
+            if constexpr (!chained)
+            {
+                (void)bytes_needed;
+                return false;
+            }
+            else
+            {
+                std::size_t last_size = chunks ? chunks->size : pool_size;
+
+                // Leaving the pool for the first time, so all of it may have been touched
+                if (!chunks)
+                    low_water = limit;
+
+                // Whole quanta keep the end of the chunk, where bumping starts, aligned
+                std::size_t size = quantised(detail::next_chunk_size<Growth>(last_size, bytes_needed));
+                chunks = detail::take_chunk(spare, size, bytes_needed, chunks);
+                next = chunks->end();
+                limit = chunks->begin();
+                return true;
+            }
+        }
+
         // Private members
         byte *pool;
         byte *next;
+        byte *limit;
+        byte *low_water = nullptr; // Lowest address touched in the pool since pages were last released
         std::size_t pool_size;
-    }; // CLASS bump_up
+        detail::chunk *chunks = nullptr;
+        detail::chunk *spare = nullptr;
+        detail::destructor *destructors = nullptr;
+        BUMP_NO_UNIQUE_ADDRESS Stats tally;
+    }; // CLASS bump_down
 
-    // Templated class for a bump down allocator
-    template <std::size_t S>
-    class bump_down
+    // Pool, next, limit, low_water, pool_size, chunks, spare and destructors, with no room for stats::none
+    static_assert(sizeof(bump_down<64>) == 8 * sizeof(void *), "Invalid. stats::none must not add to the size of bump_down.");
+
+    // Templated class for a double-ended allocator sharing one pool between a bump_up and a bump_down end
+    // Long-lived results are allocated from the bottom and short-lived scratch from the top,
+    // and allocation only fails once the two ends meet. Each end can be reset on its own.
+    template <std::size_t S, class Backing = backing::heap>
+    class bump_double_ended
     {
+        static_assert(!backing::is_reserved<Backing>::value, "Invalid. Reserved pools are only supported by bump_up.");
     public:
+        // Alignment the start of the pool is guaranteed to have, set by the backing store
+        static constexpr std::size_t base_alignment = Backing::alignment;
+
         // Constructor
-        bump_down()
+        bump_double_ended()
         {
             // Check if size is valid
             if (S < 1)
@@ -108,18 +1394,21 @@ namespace bump
                 throw std::invalid_argument("Invalid. Size must be greater than 0.");
             }
 
-            // Initialize pool size and pointers
-            pool_size = S;
-            pool = new byte[pool_size];
-            next = (pool + pool_size);
+            // Initialize pool and both ends
+            pool = Backing::acquire(S);
+            bottom = pool;
+            top = pool + S;
         }
 
+        bump_double_ended(const bump_double_ended &) = delete;
+        bump_double_ended &operator=(const bump_double_ended &) = delete;
+
         // Destructor
-        ~bump_down() { deallocate(); }
+        ~bump_double_ended() { deallocate(); }
 
-        // Allocate memory for type T
+        // Allocate memory for type T from the bottom end, bumping upwards
         template <class T>
-        T *allocate(std::size_t n)
+        T *allocate_up(std::size_t n)
         {
             // Check if allocation size is valid
             if (n < 1)
@@ -127,50 +1416,269 @@ namespace bump
 
             // Allocate pool if not initialized
             if (pool == nullptr)
-            {
-                pool = new byte[pool_size];
-                next = pool + pool_size;
-            }
+                acquire();
 
-            // Calculate required bytes and alignment
-            std::size_t bytes_needed = sizeof(T) * n;
-            std::size_t alignment = alignof(T);
-            std::size_t space_needed = bytes_needed + alignment - 1;
+            // Round the bottom pointer up to the next multiple of the required alignment
+            std::uintptr_t mask = alignof(T) - 1;
+            std::uintptr_t aligned_address = (reinterpret_cast<std::uintptr_t>(bottom) + mask) & ~mask;
+
+            // Check if the allocation would run into the top end
+            if (sizeof(T) * n > static_cast<std::size_t>(top - bottom) ||
+                reinterpret_cast<byte *>(aligned_address + sizeof(T) * n) > top)
+                return nullptr;
 
-            // Check if there is enough space in the pool
-            // if (next - pool < space_needed)
-            //     return nullptr;
+            // Update the bottom pointer and return the aligned address
+            bottom = reinterpret_cast<byte *>(aligned_address + sizeof(T) * n);
+            return reinterpret_cast<T *>(aligned_address);
+        }
 
-            // Convert the next pointer to an unsigned integer representing the raw memory address
-            std::uintptr_t raw_address = reinterpret_cast<std::uintptr_t>(next);
+        // Allocate memory for type T from the top end, bumping downwards
+        template <class T>
+        T *allocate_down(std::size_t n)
+        {
+            // Check if allocation size is valid
+            if (n < 1)
+                return nullptr;
 
-            // Calculate a mask to isolate the least significant bits that need adjustment for alignment
-            // The mask is created by inverting the bits of (alignment - 1)
-            std::uintptr_t mask = ~(alignment - 1);
+            // Allocate pool if not initialized
+            if (pool == nullptr)
+                acquire();
 
-            // Calculate the aligned address by subtracting the required bytes and applying the mask
-            // This ensures that the address is adjusted to the nearest lower multiple of the alignment
-            std::uintptr_t aligned_address = (raw_address - bytes_needed) & mask;
+            // Check if the allocation would run into the bottom end, before the subtraction can wrap
+            if (sizeof(T) * n > static_cast<std::size_t>(top - bottom))
+                return nullptr;
 
+            // Round the top pointer minus the size down to the nearest multiple of the required alignment
+            std::uintptr_t mask = ~std::uintptr_t(alignof(T) - 1);
+            std::uintptr_t aligned_address = (reinterpret_cast<std::uintptr_t>(top) - sizeof(T) * n) & mask;
 
-            // Check if the aligned address is within the pool
-            if (reinterpret_cast<byte *>(aligned_address) < pool)
+            if (reinterpret_cast<byte *>(aligned_address) < bottom)
                 return nullptr;
 
-            // Update next pointer and return the aligned address
-            next = reinterpret_cast<byte *>(aligned_address);
+            // Update the top pointer and return the aligned address
+            top = reinterpret_cast<byte *>(aligned_address);
             return reinterpret_cast<T *>(aligned_address);
         }
 
+        // Release everything allocated from the bottom end, keeping the top end intact
+        void reset_up()
+        {
+            bottom = pool;
+        }
+
+        // Release everything allocated from the top end, keeping the bottom end intact
+        void reset_down()
+        {
+            if (pool)
+                top = pool + S;
+        }
+
+        // Release both ends while keeping the pool
+        void reset()
+        {
+            reset_up();
+            reset_down();
+        }
+
         // Deallocate memory
         void deallocate()
         {
             if (pool)
             {
-                delete[] pool;
+                Backing::release(pool, S);
                 pool = nullptr;
-                next = nullptr;
+                bottom = nullptr;
+                top = nullptr;
+            }
+        }
+
+        // Number of free bytes left between the two ends
+        std::size_t available() const { return static_cast<std::size_t>(top - bottom); }
+
+        // Print the addresses of both ends
+        void print_next_addr() const
+        {
+            std::cout << "Bottom: " << reinterpret_cast<std::uintptr_t>(bottom)
+                      << " Top: " << reinterpret_cast<std::uintptr_t>(top) << std::endl;
+        }
+
+    private:
+        void acquire()
+        {
+            pool = Backing::acquire(S);
+            bottom = pool;
+            top = pool + S;
+        }
+
+        // Private members
+        byte *pool;
+        byte *bottom;
+        byte *top;
+    }; // CLASS bump_double_ended
+
+    // Templated class for a bump allocator whose pool lives inside the object itself, starting on an Align byte boundary
+    // No heap allocation is made, so small arenas can sit on the stack or be embedded in a larger struct
+    template <std::size_t S, std::size_t Align = alignof(std::max_align_t)>
+    class bump_inline
+    {
+        static_assert(S > 0, "Invalid. Size must be greater than 0.");
+        static_assert((Align & (Align - 1)) == 0, "Invalid. Alignment must be a power of two.");
+
+    public:
+        // Constructor
+        bump_inline() : next(storage) {}
+
+        // The pool is part of the object, so handing out pointers into a copy would be meaningless
+        bump_inline(const bump_inline &) = delete;
+        bump_inline &operator=(const bump_inline &) = delete;
+
+        // Destructor, running the destructors of objects built with make()
+        ~bump_inline() { detail::run_destructors(destructors); }
+
+        // Allocate memory for type T
+        template <class T>
+        T *allocate(std::size_t n)
+        {
+            // Check if allocation size is valid
+            if (n < 1)
+                return nullptr;
+
+            // Calculate required bytes and alignment
+            std::size_t bytes_needed = sizeof(T) * n;
+            std::uintptr_t mask = alignof(T) - 1;
+
+            // Round the raw address up to the next multiple of the required alignment
+            std::uintptr_t aligned_address = (reinterpret_cast<std::uintptr_t>(next) + mask) & ~mask;
+
+            // Check if allocation exceeds the inline storage
+            if (reinterpret_cast<byte *>(aligned_address + bytes_needed) > storage + S)
+                return nullptr;
+
+            // Update next pointer and return the aligned address
+            next = reinterpret_cast<byte *>(aligned_address + bytes_needed);
+            return reinterpret_cast<T *>(aligned_address);
+        }
+
+        // Allocate size bytes aligned to alignment, which must be a power of two
+        void *allocate_bytes(std::size_t size, std::size_t alignment)
+        {
+            if (size < 1)
+                return nullptr;
+
+            std::uintptr_t mask = alignment - 1;
+            std::uintptr_t aligned_address = (reinterpret_cast<std::uintptr_t>(next) + mask) & ~mask;
+
+            if (reinterpret_cast<byte *>(aligned_address + size) > storage + S)
+                return nullptr;
+
+            next = reinterpret_cast<byte *>(aligned_address + size);
+            return reinterpret_cast<void *>(aligned_address);
+        }
+
+        // Allocate n objects of type T aligned to alignment (a power of two), or alignof(T) if that is stricter
+        // e.g. allocate_aligned<float>(n, 64) for cache line or AVX-512 aligned buffers
+        template <class T>
+        T *allocate_aligned(std::size_t n, std::size_t alignment)
+        {
+            return static_cast<T *>(allocate_bytes(sizeof(T) * n, std::max(alignment, alignof(T))));
+        }
+
+        // Grow the array at ptr from old_n to new_n objects in place, only possible while it is the most recent allocation
+        // Returns false (and changes nothing) if something was allocated after it or the pool has no room left
+        template <class T>
+        bool try_extend(T *ptr, std::size_t old_n, std::size_t new_n)
+        {
+            if (ptr == nullptr || reinterpret_cast<byte *>(ptr + old_n) != next || new_n < old_n)
+                return false;
+            if (new_n - old_n > static_cast<std::size_t>((storage + S) - next) / sizeof(T))
+                return false;
+
+            next = reinterpret_cast<byte *>(ptr + new_n);
+            return true;
+        }
+
+        // Give back the tail of the array at ptr beyond new_n objects, only possible while it is the most recent allocation
+        template <class T>
+        bool shrink(T *ptr, std::size_t old_n, std::size_t new_n)
+        {
+            if (ptr == nullptr || reinterpret_cast<byte *>(ptr + old_n) != next || new_n > old_n)
+                return false;
+
+            next = reinterpret_cast<byte *>(ptr + new_n);
+            return true;
+        }
+
+        // Resize the array at ptr to new_n objects, like realloc
+        // Adjusts next in place when ptr is the most recent allocation and only copies into a new block otherwise
+        template <class T>
+        T *reallocate(T *ptr, std::size_t old_n, std::size_t new_n)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Invalid. reallocate copies objects bytewise.");
+
+            if (ptr == nullptr)
+                return allocate<T>(new_n);
+            if (new_n <= old_n)
+            {
+                shrink(ptr, old_n, new_n);
+                return ptr;
             }
+            if (try_extend(ptr, old_n, new_n))
+                return ptr;
+
+            T *moved = allocate<T>(new_n);
+            if (moved != nullptr)
+                std::memcpy(moved, ptr, sizeof(T) * old_n);
+            return moved;
+        }
+
+        // Allocate one array of each type Ts with the matching count in n, with one capacity check for the batch
+        // Either every array is allocated or the result is all nullptr (arrays with a count of 0 are always nullptr)
+        template <class... Ts>
+        std::tuple<Ts *...> allocate_many(detail::count_t<Ts>... n)
+        {
+            std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(next);
+            std::uintptr_t addresses[] = {detail::place_up<Ts>(cursor, n)...};
+
+            if (reinterpret_cast<byte *>(cursor) > storage + S)
+                return std::tuple<Ts *...>();
+
+            next = reinterpret_cast<byte *>(cursor);
+            return detail::typed_tuple<Ts...>(addresses, std::index_sequence_for<Ts...>());
+        }
+
+        // Construct a T from args in the arena, its destructor runs on reset(), deallocate() or destruction
+        // Only types that are not trivially destructible cost a destructor record
+        template <class T, class... Args>
+        T *make(Args &&...args)
+        {
+            return detail::make<T>(*this, destructors, std::forward<Args>(args)...);
+        }
+
+        // Construct n objects of type T, each from args, see make()
+        template <class T, class... Args>
+        T *make_array(std::size_t n, const Args &...args)
+        {
+            return detail::make_array<T>(*this, destructors, n, args...);
+        }
+
+        // Deallocate memory, which for inline storage only rewinds to the start
+        void deallocate() { reset(); }
+
+        // Rewind next to the start of the storage
+        void reset()
+        {
+            detail::run_destructors(destructors);
+            next = storage;
+        }
+
+        // Current allocation position, to be passed to rewind()
+        checkpoint marker() const { return checkpoint{next, nullptr, destructors}; }
+
+        // Release everything allocated since m was taken
+        void rewind(const checkpoint &m)
+        {
+            detail::run_destructors(destructors, m.destructors);
+            next = m.next;
         }
 
         // Print the next address in the pool
@@ -181,9 +1689,26 @@ namespace bump
 
     private:
         // Private members
-        byte *pool;
+        alignas(Align) byte storage[S];
         byte *next;
-        std::size_t pool_size;
-    }; // CLASS bump_down
+        detail::destructor *destructors = nullptr;
+    }; // CLASS bump_inline
+
+    // Scope guard rewinding an allocator to where it was when the guard was created
+    // Allocations made while the guard is alive must not be used after it goes out of scope
+    template <class Allocator>
+    class scope
+    {
+    public:
+        explicit scope(Allocator &allocator) : allocator(allocator), saved(allocator.marker()) {}
+        ~scope() { allocator.rewind(saved); }
+
+        scope(const scope &) = delete;
+        scope &operator=(const scope &) = delete;
+
+    private:
+        Allocator &allocator;
+        checkpoint saved;
+    }; // CLASS scope
 
 } // namespace bump
\ No newline at end of file
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "bump.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+
+namespace bump
+{
+    // Assumed cache line size, used to keep contended members from sharing a line
+    constexpr std::size_t cache_line = 64;
+
+    // Central supplier of ChunkSize byte chunks shared by many thread_arena front ends
+    // Chunks released by an arena are kept on a free list and handed to the next arena that runs out,
+    // so memory follows the threads that are actually allocating instead of being reserved per thread
+    template <std::size_t ChunkSize>
+    class chunk_supplier
+    {
+        static_assert(ChunkSize > 0, "Invalid. Chunk size must be greater than 0.");
+
+    public:
+        chunk_supplier() = default;
+        chunk_supplier(const chunk_supplier &) = delete;
+        chunk_supplier &operator=(const chunk_supplier &) = delete;
+
+        // Every arena fed by this supplier must have been reset or destroyed first
+        ~chunk_supplier() { detail::free_chunks(free); }
+
+        // Hand out a chunk able to hold bytes_needed, linked in front of prev
+        // Requests larger than ChunkSize get a dedicated chunk that is freed rather than recycled on release
+        detail::chunk *acquire(std::size_t bytes_needed, detail::chunk *prev)
+        {
+            if (bytes_needed > ChunkSize)
+                return detail::new_chunk(bytes_needed, prev);
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (free)
+                {
+                    detail::chunk *c = free;
+                    free = free->prev;
+                    c->prev = prev;
+                    return c;
+                }
+            }
+
+            // Allocate outside the lock so other threads can keep recycling
+            return detail::new_chunk(ChunkSize, prev);
+        }
+
+        // Take back a whole list of chunks, linked through prev, with a single lock acquisition
+        void release(detail::chunk *head)
+        {
+            detail::chunk *recycled = nullptr;
+            detail::chunk *tail = nullptr;
+
+            // Sort the list into recyclable chunks and dedicated oversized ones without holding the lock
+            while (head)
+            {
+                detail::chunk *prev = head->prev;
+                if (head->size == ChunkSize)
+                {
+                    head->prev = recycled;
+                    recycled = head;
+                    if (!tail)
+                        tail = head;
+                }
+                else
+                {
+                    delete[] reinterpret_cast<byte *>(head);
+                }
+                head = prev;
+            }
+
+            if (recycled)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                tail->prev = free;
+                free = recycled;
+            }
+        }
+
+    private:
+        std::mutex lock;
+        detail::chunk *free = nullptr;
+    }; // CLASS chunk_supplier
+
+    // Per-thread bump_up front end refilled from a chunk_supplier
+    // Allocation is a plain pointer bump in the current chunk with no atomics or locks,
+    // only running out of the chunk goes to the supplier. Each thread must use its own instance.
+    template <std::size_t ChunkSize>
+    class thread_arena
+    {
+    public:
+        explicit thread_arena(chunk_supplier<ChunkSize> &supplier) : supplier(supplier) {}
+        thread_arena(const thread_arena &) = delete;
+        thread_arena &operator=(const thread_arena &) = delete;
+
+        // Destructor
+        ~thread_arena() { reset(); }
+
+        // Allocate memory for type T
+        template <class T>
+        T *allocate(std::size_t n)
+        {
+            return static_cast<T *>(allocate_bytes(sizeof(T) * n, alignof(T)));
+        }
+
+        // Allocate size bytes aligned to alignment, which must be a power of two
+        void *allocate_bytes(std::size_t size, std::size_t alignment)
+        {
+            // Check if allocation size is valid
+            if (size < 1)
+                return nullptr;
+
+            // Round the raw address up to the next multiple of the required alignment
+            std::uintptr_t mask = alignment - 1;
+            std::uintptr_t aligned_address = (reinterpret_cast<std::uintptr_t>(next) + mask) & ~mask;
+
+            // Refill from the supplier when the current chunk is exhausted (or none has been taken yet)
+            if (next == nullptr || reinterpret_cast<byte *>(aligned_address + size) > limit)
+            {
+                chunks = supplier.acquire(size + mask, chunks);
+                next = chunks->begin();
+                limit = chunks->end();
+                return allocate_bytes(size, alignment);
+            }
+
+            // Update next pointer and return the aligned address
+            next = reinterpret_cast<byte *>(aligned_address + size);
+            return reinterpret_cast<void *>(aligned_address);
+        }
+
+        // Give every chunk back to the supplier for other threads to reuse
+        void reset()
+        {
+            supplier.release(chunks);
+            chunks = nullptr;
+            next = nullptr;
+            limit = nullptr;
+        }
+
+        // Print the next address in the current chunk
+        void print_next_addr() const
+        {
+            std::cout << "Address: " << reinterpret_cast<std::uintptr_t>(next) << std::endl;
+        }
+
+    private:
+        // Private members
+        chunk_supplier<ChunkSize> &supplier;
+        detail::chunk *chunks = nullptr;
+        byte *next = nullptr;
+        byte *limit = nullptr;
+    }; // CLASS thread_arena
+
+    // Templated class for a bump_up allocator that many threads can allocate from at once
+    // next is advanced with a compare-and-swap loop, so it never moves past the end of the pool
+    // and an exhausted pool fails cleanly for every thread
+    template <std::size_t S>
+    class concurrent_bump_up
+    {
+    public:
+        // Constructor
+        concurrent_bump_up()
+        {
+            // Check if size is valid
+            if (S < 1)
+            {
+                throw std::invalid_argument("Invalid. Size must be greater than 0.");
+            }
+
+            // Initialize pool and pointers
+            pool = new byte[S];
+            end = reinterpret_cast<std::uintptr_t>(pool) + S;
+            next.store(reinterpret_cast<std::uintptr_t>(pool), std::memory_order_relaxed);
+        }
+
+        concurrent_bump_up(const concurrent_bump_up &) = delete;
+        concurrent_bump_up &operator=(const concurrent_bump_up &) = delete;
+
+        // Destructor
+        ~concurrent_bump_up() { delete[] pool; }
+
+        // Allocate memory for type T, safe to call from any number of threads
+        template <class T>
+        T *allocate(std::size_t n)
+        {
+            return static_cast<T *>(allocate_bytes(sizeof(T) * n, alignof(T)));
+        }
+
+        // Allocate size bytes aligned to alignment, which must be a power of two
+        void *allocate_bytes(std::size_t size, std::size_t alignment)
+        {
+            // Check if allocation size is valid
+            if (size < 1)
+                return nullptr;
+
+            std::uintptr_t mask = alignment - 1;
+            std::uintptr_t current = next.load(std::memory_order_relaxed);
+            std::uintptr_t aligned_address;
+
+            // Each thread only reserves a disjoint range, publishing what is written into it is up to the caller,
+            // so relaxed ordering is enough. A failed exchange reloads current and the padding is recomputed.
+            do
+            {
+                aligned_address = (current + mask) & ~mask;
+                if (aligned_address + size > end || aligned_address + size < current)
+                    return nullptr;
+            } while (!next.compare_exchange_weak(current, aligned_address + size, std::memory_order_relaxed));
+
+            return reinterpret_cast<void *>(aligned_address);
+        }
+
+        // Rewind next to the start of the pool, only safe while no other thread is allocating
+        void reset()
+        {
+            next.store(reinterpret_cast<std::uintptr_t>(pool), std::memory_order_relaxed);
+        }
+
+        // Print the next address in the pool
+        void print_next_addr() const
+        {
+            std::cout << "Address: " << next.load(std::memory_order_relaxed) << std::endl;
+        }
+
+    private:
+        // The contended cursor and the read-only bounds sit on separate cache lines,
+        // so threads reading the bounds are not invalidated by every bump
+        alignas(cache_line) std::atomic<std::uintptr_t> next;
+        alignas(cache_line) byte *pool;
+        std::uintptr_t end;
+    }; // CLASS concurrent_bump_up
+
+} // namespace bump
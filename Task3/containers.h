@@ -0,0 +1,462 @@
+#pragma once
+
+#include "bump.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace bump
+{
+    namespace detail
+    {
+        // Whether Arena can grow its most recent allocation of T in place (bump_up and bump_inline)
+        template <class Arena, class T, class = void>
+        struct can_extend : std::false_type
+        {
+        };
+
+        template <class Arena, class T>
+        struct can_extend<Arena, T, std::void_t<decltype(std::declval<Arena &>().template try_extend<T>(std::declval<T *>(), std::size_t(), std::size_t()))>>
+            : std::true_type
+        {
+        };
+
+        // Grow the block of old_n objects at ptr to new_n without moving it, false if it is not the top allocation
+        template <class T, class Arena>
+        bool extend_in_place(Arena &arena, T *ptr, std::size_t old_n, std::size_t new_n)
+        {
+            if constexpr (can_extend<Arena, T>::value)
+                return arena.template try_extend<T>(ptr, old_n, new_n);
+            else
+                return false;
+        }
+    } // namespace detail
+
+    // Growable array in an arena (bump_up, bump_down or bump_inline) that never copies its elements
+    // When the storage is the arena's most recent allocation it grows in place, otherwise a segment of twice the size
+    // is linked after it, so abandoned buffers are never left behind. Indexing walks the segments, which stay few
+    // because they double. Elements must be trivially destructible, nothing is destroyed or freed.
+    template <class T, class Arena>
+    class bump_vector
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Invalid. bump_vector never runs destructors.");
+
+        // Run of elements stored contiguously, the header is allocated just before its elements
+        struct segment
+        {
+            T *data;
+            std::size_t size;
+            std::size_t capacity;
+            segment *next;
+        };
+
+        static constexpr std::size_t first_capacity = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+
+    public:
+        // Forward iterator over every element, segment by segment
+        template <class Value>
+        class basic_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef Value value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef Value *pointer;
+            typedef Value &reference;
+
+            basic_iterator(segment *s, std::size_t i) : s(s), i(i) {}
+
+            reference operator*() const { return s->data[i]; }
+            pointer operator->() const { return s->data + i; }
+
+            basic_iterator &operator++()
+            {
+                // Segments before the last one in use are always full
+                if (++i == s->size && s->next && s->next->size)
+                {
+                    s = s->next;
+                    i = 0;
+                }
+                return *this;
+            }
+
+            bool operator==(const basic_iterator &other) const { return s == other.s && i == other.i; }
+            bool operator!=(const basic_iterator &other) const { return !(*this == other); }
+
+        private:
+            segment *s;
+            std::size_t i;
+        }; // CLASS basic_iterator
+
+        typedef basic_iterator<T> iterator;
+        typedef basic_iterator<const T> const_iterator;
+
+        explicit bump_vector(Arena &arena) : arena(arena) {}
+
+        // Append a copy of value, returns the stored element or nullptr if the arena is exhausted
+        T *push_back(const T &value) { return emplace_back(value); }
+
+        // Construct an element at the end from args, returns it or nullptr if the arena is exhausted
+        template <class... Args>
+        T *emplace_back(Args &&...args)
+        {
+            if ((tail == nullptr || tail->size == tail->capacity) && !grow())
+                return nullptr;
+
+            T *element = tail->data + tail->size;
+            detail::construct(element, std::forward<Args>(args)...);
+            ++tail->size;
+            ++count;
+            return element;
+        }
+
+        // Element at index i, found in the first segment unless the vector has been split
+        T &operator[](std::size_t i) { return at_index(i); }
+        const T &operator[](std::size_t i) const { return at_index(i); }
+
+        T &back() { return tail->data[tail->size - 1]; }
+        const T &back() const { return tail->data[tail->size - 1]; }
+
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        // Whether every element is in one array, which data() then points to
+        bool contiguous() const { return head == tail; }
+        T *data() const { return head ? head->data : nullptr; }
+
+        // Forget every element, keeping the segments for the next ones
+        void clear()
+        {
+            for (segment *s = head; s; s = s->next)
+                s->size = 0;
+            tail = head;
+            count = 0;
+        }
+
+        iterator begin() { return iterator(head, 0); }
+        iterator end() { return iterator(tail, tail ? tail->size : 0); }
+        const_iterator begin() const { return const_iterator(head, 0); }
+        const_iterator end() const { return const_iterator(tail, tail ? tail->size : 0); }
+
+        Arena &get_arena() const { return arena; }
+
+    private:
+        // Make room for one more element after tail, false if the arena is exhausted
+        bool grow()
+        {
+            if (tail == nullptr)
+                return (head = tail = new_segment(first_capacity)) != nullptr;
+
+            // Segments kept by clear() are refilled first
+            if (tail->next)
+            {
+                tail = tail->next;
+                return true;
+            }
+
+            // Double in place while nothing else has been allocated after the elements
+            if (detail::extend_in_place(arena, tail->data, tail->capacity, tail->capacity * 2))
+            {
+                tail->capacity *= 2;
+                return true;
+            }
+
+            segment *next = new_segment(tail->capacity * 2);
+            if (next == nullptr)
+                return false;
+            tail = tail->next = next;
+            return true;
+        }
+
+        segment *new_segment(std::size_t capacity)
+        {
+            segment *s = arena.template allocate<segment>(1);
+            T *data = s ? arena.template allocate<T>(capacity) : nullptr;
+            if (data == nullptr)
+                return nullptr;
+            return new (s) segment{data, 0, capacity, nullptr};
+        }
+
+        T &at_index(std::size_t i) const
+        {
+            segment *s = head;
+            while (i >= s->size)
+            {
+                i -= s->size;
+                s = s->next;
+            }
+            return s->data[i];
+        }
+
+        // Private members
+        Arena &arena;
+        segment *head = nullptr;
+        segment *tail = nullptr;
+        std::size_t count = 0;
+    }; // CLASS bump_vector
+
+    // Null terminated string built up in an arena, for names, paths and response bodies
+    // Appends extend the buffer in place while it is the arena's most recent allocation, otherwise the text moves to
+    // a buffer of twice the capacity. The text stays valid until the arena is reset, nothing needs to be freed.
+    template <class Arena>
+    class bump_string
+    {
+        static constexpr std::size_t first_capacity = 32;
+
+    public:
+        explicit bump_string(Arena &arena) : arena(arena) {}
+
+        // Append text, false if the arena is exhausted (the string is then unchanged)
+        bool append(std::string_view text)
+        {
+            if (length + text.size() > capacity && !reserve(std::max(length + text.size(), capacity * 2)))
+                return false;
+
+            std::memcpy(chars + length, text.data(), text.size());
+            length += text.size();
+            chars[length] = '\0';
+            return true;
+        }
+
+        bool push_back(char c) { return append(std::string_view(&c, 1)); }
+
+        // Make room for at least new_capacity characters plus the terminator, false if the arena is exhausted
+        bool reserve(std::size_t new_capacity)
+        {
+            if (new_capacity <= capacity)
+                return true;
+            new_capacity = std::max(new_capacity, first_capacity);
+
+            if (chars && detail::extend_in_place(arena, chars, capacity + 1, new_capacity + 1))
+            {
+                capacity = new_capacity;
+                return true;
+            }
+
+            char *moved = arena.template allocate<char>(new_capacity + 1);
+            if (moved == nullptr)
+                return false;
+            if (chars)
+                std::memcpy(moved, chars, length + 1);
+            chars = moved;
+            capacity = new_capacity;
+            return true;
+        }
+
+        std::string_view view() const { return std::string_view(c_str(), length); }
+        const char *c_str() const { return chars ? chars : ""; }
+        operator std::string_view() const { return view(); }
+
+        std::size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+
+        // Forget the text, keeping the buffer
+        void clear()
+        {
+            length = 0;
+            if (chars)
+                chars[0] = '\0';
+        }
+
+        Arena &get_arena() const { return arena; }
+
+    private:
+        // Private members
+        Arena &arena;
+        char *chars = nullptr;
+        std::size_t length = 0;
+        std::size_t capacity = 0;
+    }; // CLASS bump_string
+
+    // Flat open-addressing hash map with linear probing, its tables allocated in an arena
+    // Erasing shifts the following entries back instead of leaving tombstones, so probes stay short.
+    // Growing doubles the table and abandons the old one in the arena. Keys and values must be trivially destructible,
+    // a std::string_view key pointing into the same arena keeps string keys allocation free.
+    template <class Key, class Value, class Arena, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class bump_map
+    {
+        static_assert(std::is_trivially_destructible_v<Key> && std::is_trivially_destructible_v<Value>,
+                      "Invalid. bump_map never runs destructors.");
+
+        struct slot
+        {
+            Key key;
+            Value value;
+        };
+
+        static constexpr std::size_t first_capacity = 16;
+
+    public:
+        explicit bump_map(Arena &arena) : arena(arena) {}
+
+        // Value stored for key, or nullptr if there is none
+        Value *find(const Key &key) const
+        {
+            if (count == 0)
+                return nullptr;
+
+            for (std::size_t i = home(key);; i = (i + 1) & mask)
+            {
+                if (!used[i])
+                    return nullptr;
+                if (equal(slots[i].key, key))
+                    return &slots[i].value;
+            }
+        }
+
+        bool contains(const Key &key) const { return find(key) != nullptr; }
+
+        // Set the value stored for key, inserting it if needed
+        // Returns the stored value, or nullptr if the table had to grow and the arena is exhausted
+        Value *insert(const Key &key, const Value &value)
+        {
+            // Update an existing entry in place, which never needs a bigger table
+            std::size_t i = 0;
+            if (used)
+            {
+                for (i = home(key); used[i]; i = (i + 1) & mask)
+                {
+                    if (equal(slots[i].key, key))
+                    {
+                        slots[i].value = value;
+                        return &slots[i].value;
+                    }
+                }
+            }
+
+            // A new entry is added, keep the load factor at or below 7/8 and find its free slot in the new table
+            if ((count + 1) * 8 > capacity() * 7)
+            {
+                if (!rehash(capacity() ? capacity() * 2 : first_capacity))
+                    return nullptr;
+                i = home(key);
+                while (used[i])
+                    i = (i + 1) & mask;
+            }
+
+            used[i] = 1;
+            new (&slots[i]) slot{key, value};
+            ++count;
+            return &slots[i].value;
+        }
+
+        // Remove key, false if it was not present
+        bool erase(const Key &key)
+        {
+            if (count == 0)
+                return false;
+
+            std::size_t i = home(key);
+            for (; used[i]; i = (i + 1) & mask)
+            {
+                if (equal(slots[i].key, key))
+                    break;
+            }
+            if (!used[i])
+                return false;
+
+            // Shift back every following entry whose home is at or before the hole, ending at the first free slot
+            std::size_t hole = i;
+            for (std::size_t j = (i + 1) & mask; used[j]; j = (j + 1) & mask)
+            {
+                std::size_t distance = (j - home(slots[j].key)) & mask;
+                if (distance >= ((j - hole) & mask))
+                {
+                    slots[hole] = slots[j];
+                    hole = j;
+                }
+            }
+            used[hole] = 0;
+            --count;
+            return true;
+        }
+
+        // Call f(key, value) for every entry, in table order
+        template <class Function>
+        void for_each(Function f)
+        {
+            for (std::size_t i = 0; i < capacity(); ++i)
+            {
+                if (used[i])
+                    f(static_cast<const Key &>(slots[i].key), slots[i].value);
+            }
+        }
+
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        // Remove every entry, keeping the table
+        void clear()
+        {
+            if (used)
+                std::memset(used, 0, capacity());
+            count = 0;
+        }
+
+        Arena &get_arena() const { return arena; }
+
+    private:
+        std::size_t capacity() const { return used ? mask + 1 : 0; }
+
+        // Slot a key probes first, the hash is multiplied by 2^64 / phi so keys with poor low bits
+        // (std::hash of integers is the identity) still spread over the table
+        std::size_t home(const Key &key) const
+        {
+            std::uint64_t h = static_cast<std::uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<std::size_t>(h >> shift);
+        }
+
+        // Move every entry into a new table of new_capacity slots (a power of two), false if the arena is exhausted
+        bool rehash(std::size_t new_capacity)
+        {
+            std::uint8_t *new_used = arena.template allocate<std::uint8_t>(new_capacity);
+            slot *new_slots = new_used ? arena.template allocate<slot>(new_capacity) : nullptr;
+            if (new_slots == nullptr)
+                return false;
+            std::memset(new_used, 0, new_capacity);
+
+            std::uint8_t *old_used = used;
+            slot *old_slots = slots;
+            std::size_t old_capacity = capacity();
+
+            used = new_used;
+            slots = new_slots;
+            mask = new_capacity - 1;
+            shift = 64;
+            for (std::size_t c = new_capacity; c > 1; c >>= 1)
+                --shift;
+
+            for (std::size_t j = 0; j < old_capacity; ++j)
+            {
+                if (!old_used[j])
+                    continue;
+
+                std::size_t i = home(old_slots[j].key);
+                while (used[i])
+                    i = (i + 1) & mask;
+                used[i] = 1;
+                new (&slots[i]) slot(old_slots[j]);
+            }
+            return true;
+        }
+
+        // Private members
+        Arena &arena;
+        std::uint8_t *used = nullptr;
+        slot *slots = nullptr;
+        std::size_t mask = 0;
+        unsigned shift = 64;
+        std::size_t count = 0;
+        Hash hasher;
+        KeyEqual equal;
+    }; // CLASS bump_map
+
+} // namespace bump
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "bump.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+
+namespace bump
+{
+    // Handle to a string stored once by an interner, equal strings of one interner get equal symbols
+    // Comparing and hashing symbols compares and hashes a pointer, the text is only read by view() and c_str()
+    class symbol
+    {
+    public:
+        symbol() = default;
+
+        // The interned text, valid until the interner's arena is reset
+        std::string_view view() const
+        {
+            if (entry == nullptr)
+                return std::string_view();
+
+            std::uint32_t length;
+            std::memcpy(&length, entry, sizeof(length));
+            return std::string_view(entry + sizeof(length), length);
+        }
+
+        const char *c_str() const { return entry ? entry + sizeof(std::uint32_t) : ""; }
+
+        // False for the empty symbol returned when interning fails or find() has no match
+        explicit operator bool() const { return entry != nullptr; }
+
+        bool operator==(const symbol &other) const { return entry == other.entry; }
+        bool operator!=(const symbol &other) const { return entry != other.entry; }
+        bool operator<(const symbol &other) const { return std::less<const char *>()(entry, other.entry); }
+
+    private:
+        template <class Arena>
+        friend class interner;
+
+        explicit symbol(const char *entry) : entry(entry) {}
+
+        // Length prefix followed by the characters and a terminating null
+        const char *entry = nullptr;
+    }; // CLASS symbol
+
+    // Deduplicating symbol table in an arena (usually bump_up with growth)
+    // Each distinct string is copied once into the arena as a 4 byte length, its characters and a null, one after
+    // another. The hash index is an open-addressing table in the same arena that doubles when it is 3/4 full,
+    // storing each string's hash so probes only read the text on a hash match. Nothing is freed one by one,
+    // reset() or deallocate() drops the whole table with the arena.
+    template <class Arena>
+    class interner
+    {
+        // Index entry, an empty slot has a null entry
+        struct slot
+        {
+            std::uint64_t hash;
+            const char *entry;
+        };
+
+        static constexpr std::size_t first_capacity = 64;
+
+    public:
+        explicit interner(Arena &arena) : arena(arena) {}
+
+        // Symbol for text, copying it into the arena the first time it is seen
+        // Returns the empty symbol if the arena is exhausted
+        symbol intern(std::string_view text)
+        {
+            if (text.size() > std::numeric_limits<std::uint32_t>::max())
+                throw std::invalid_argument("Invalid. Interned strings must be shorter than 4GB.");
+
+            // Text seen before is found without growing the table
+            std::uint64_t hash = hash_of(text);
+            std::size_t i = 0;
+            if (slots)
+            {
+                i = probe(text, hash);
+                if (slots[i].entry)
+                    return symbol(slots[i].entry);
+            }
+
+            // A new entry is added, keep the load factor at or below 3/4 and find its empty slot in the new table
+            if ((count + 1) * 4 > capacity() * 3)
+            {
+                if (!rehash(capacity() ? capacity() * 2 : first_capacity))
+                    return symbol();
+                i = probe(text, hash);
+            }
+
+            // Copy the length, the characters and a null, unaligned so entries pack back to back
+            std::uint32_t length = static_cast<std::uint32_t>(text.size());
+            char *entry = arena.template allocate<char>(sizeof(length) + text.size() + 1);
+            if (entry == nullptr)
+                return symbol();
+            std::memcpy(entry, &length, sizeof(length));
+            std::memcpy(entry + sizeof(length), text.data(), text.size());
+            entry[sizeof(length) + text.size()] = '\0';
+
+            slots[i] = slot{hash, entry};
+            ++count;
+            return symbol(entry);
+        }
+
+        // Symbol for text if it has been interned, the empty symbol otherwise
+        symbol find(std::string_view text) const
+        {
+            if (count == 0)
+                return symbol();
+            return symbol(slots[probe(text, hash_of(text))].entry);
+        }
+
+        // Number of distinct strings interned
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        // Forget every symbol and reset the arena, symbols handed out before are invalidated
+        void reset()
+        {
+            forget();
+            arena.reset();
+        }
+
+        // Forget every symbol and free the arena's memory
+        void deallocate()
+        {
+            forget();
+            arena.deallocate();
+        }
+
+        Arena &get_arena() const { return arena; }
+
+    private:
+        std::size_t capacity() const { return slots ? mask + 1 : 0; }
+
+        static std::uint64_t hash_of(std::string_view text)
+        {
+            return static_cast<std::uint64_t>(std::hash<std::string_view>()(text));
+        }
+
+        static bool matches(const char *entry, std::string_view text)
+        {
+            std::uint32_t length;
+            std::memcpy(&length, entry, sizeof(length));
+            return length == text.size() && std::memcmp(entry + sizeof(length), text.data(), text.size()) == 0;
+        }
+
+        // Slot holding text, or the empty slot where it would be inserted
+        std::size_t probe(std::string_view text, std::uint64_t hash) const
+        {
+            std::size_t i = static_cast<std::size_t>(hash) & mask;
+            while (slots[i].entry && (slots[i].hash != hash || !matches(slots[i].entry, text)))
+                i = (i + 1) & mask;
+            return i;
+        }
+
+        // Move the index into a table of new_capacity slots (a power of two), false if the arena is exhausted
+        // The old table is left in the arena, the tables together stay under twice the final one
+        bool rehash(std::size_t new_capacity)
+        {
+            slot *new_slots = arena.template allocate<slot>(new_capacity);
+            if (new_slots == nullptr)
+                return false;
+            for (std::size_t i = 0; i < new_capacity; ++i)
+                new (&new_slots[i]) slot{0, nullptr};
+
+            std::size_t new_mask = new_capacity - 1;
+            for (std::size_t j = 0; j < capacity(); ++j)
+            {
+                if (slots[j].entry == nullptr)
+                    continue;
+
+                std::size_t i = static_cast<std::size_t>(slots[j].hash) & new_mask;
+                while (new_slots[i].entry)
+                    i = (i + 1) & new_mask;
+                new_slots[i] = slots[j];
+            }
+
+            slots = new_slots;
+            mask = new_mask;
+            return true;
+        }
+
+        void forget()
+        {
+            slots = nullptr;
+            mask = 0;
+            count = 0;
+        }
+
+        // Private members
+        Arena &arena;
+        slot *slots = nullptr;
+        std::size_t mask = 0;
+        std::size_t count = 0;
+    }; // CLASS interner
+
+} // namespace bump
+
+namespace std
+{
+    // Symbols hash by identity, so they can key std and bump containers
+    template <>
+    struct hash<bump::symbol>
+    {
+        std::size_t operator()(const bump::symbol &s) const noexcept { return std::hash<const char *>()(s.c_str()); }
+    };
+} // namespace std
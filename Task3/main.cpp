@@ -1,6 +1,22 @@
 #include "bump.h"
 #include "bench.h"
+#include "resource.h"
+#include "concurrent.h"
+#include "persist.h"
+#include "trace.h"
+#include "recycling.h"
+#include "slab.h"
+#include "containers.h"
+#include "interner.h"
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 // obs initialsing allocator to 4 and then allocating 1 int caused seg fault
 // obs in single allocation: Compilers can optimize code differently, and the generated assembly might favor one allocator over the other. The specifics of how the compiler optimizes your code can influence performance.
@@ -15,6 +31,69 @@ void MixedSizeAllocationsBumpUp(void);
 void MixedSizeAllocationsBumpDown(void);
 void LoopAllocationAndDeallocationBumpUp(bump::bump_up<4096> &);
 void LoopAllocationAndDeallocationBumpDown(bump::bump_down<4096> &);
+void LoopAllocationAndResetBumpUp(bump::bump_up<4096> &);
+void LoopAllocationAndResetBumpDown(bump::bump_down<4096> &);
+void NestedScopedAllocationsBumpUp(bump::bump_up<4096> &);
+void PmrContainersBumpResource(bump::bump_up<65536> &);
+void PmrContainersMonotonicBufferResource(void);
+void ThreadArenaAllocations(bump::chunk_supplier<65536> &);
+void ThreadHeapAllocations(void);
+void SharedAllocationsConcurrentBumpUp(bump::concurrent_bump_up<1 << 24> &);
+void SharedAllocationsMutexBumpUp(bump::bump_up<1 << 24> &);
+
+// 64MB arenas on the heap and on pre-faulted transparent huge pages
+typedef bump::bump_up<64 << 20> heap_arena;
+typedef bump::bump_up<64 << 20, bump::growth::fixed, bump::backing::mapped<bump::backing::pages::transparent_huge, true>> huge_arena;
+
+void MakeObjectsBumpUp(bump::bump_up<4096> &);
+void ResultsAndScratchDoubleEnded(bump::bump_double_ended<8192> &);
+void ResultsAndScratchSeparate(bump::bump_up<4096> &, bump::bump_down<4096> &);
+void GrowableBufferReallocateBumpUp(bump::bump_up<65536> &);
+void GrowableBufferCopyBumpUp(bump::bump_up<65536> &);
+void BuildPersistentTable(void);
+void MapPersistentTable(void);
+
+template <class Allocator>
+void FirstTouch(Allocator &);
+template <class Allocator>
+void RandomAccess(Allocator &);
+template <class Allocator>
+void RequestAllocations(Allocator &);
+// Hash map style node, churned by the Node Churn and Node Bursts benchmarks
+struct churn_node
+{
+    long key;
+    churn_node *next;
+    double value;
+};
+
+void NodeChurnRecycling(bump::recycling<bump::bump_up<4096>> &);
+void NodeChurnHeap(void);
+void NodeChurnSlab(bump::slab<churn_node> &);
+void NodeBurstsSlab(bump::slab<churn_node> &);
+void NodeBurstsHeap(void);
+
+// The same arena with every size rounded up to 8 bytes, so no allocation of alignment 8 or less needs rounding
+typedef bump::bump_up<4096, bump::growth::fixed, bump::backing::heap, bump::stats::none, 8> quantised_arena;
+
+template <class Allocator>
+void SmallMixedAllocations(Allocator &);
+
+void RequestContainersBumpUp(bump::bump_up<65536> &);
+void RequestContainersStd(void);
+
+typedef bump::bump_up<1 << 16, bump::growth::geometric<>> symbol_arena;
+
+void ParseTokensInterned(bump::interner<symbol_arena> &);
+void ParseTokensHeapStrings(void);
+
+// 64GB reservation committed 1MB at a time, against 64KB chunks chained with geometric growth
+typedef bump::bump_up<(std::size_t(64) << 30), bump::growth::committed<>, bump::backing::reserved> reserved_arena;
+typedef bump::bump_up<1 << 16, bump::growth::geometric<>> chained_arena;
+
+template <class Allocator>
+void VectorGrowth(Allocator &);
+void VectorGrowthStd(void);
 
 void test(bump::bump_down<1600> &allocator)
 {
@@ -24,8 +103,11 @@ void test(bump::bump_down<1600> &allocator)
     short *s = allocator.allocate<short>(100);
 }
 
-int main()
+int main(int argc, char **argv)
 {
+    // Harness options such as --format=json --output=results.json
+    benchmark::configure(argc, argv);
+
     // Bump up Single Allocations r-value reference
     auto bench_single_allocations_bup = benchmark::run_benchmark(
         "Single Allocations (Bump Up (lambda: pass by r-value reference (&&)))",
@@ -34,6 +116,10 @@ int main()
         {
             int *i = allocator.allocate<int>(1);
             *i = 42;
+            benchmark::do_not_optimize(i);
+
+            // Every call measures an allocation from a fresh pool
+            allocator.reset();
         },
         bump::bump_up<4096>()
     );
@@ -46,12 +132,33 @@ int main()
         [](bump::bump_down<4096> &&allocator)
         {
             int* i = allocator.allocate<int>(1);
-            *i = 42; 
+            *i = 42;
+            benchmark::do_not_optimize(i);
+
+            // Every call measures an allocation from a fresh pool
+            allocator.reset();
         },
         bump::bump_down<4096>()
     );
     std::cout << "Average time taken per run: " << bench_single_allocations_bdown << "ns\n\n";
 
+    // Bump Inline Single Allocations r-value reference
+    auto bench_single_allocations_binline = benchmark::run_benchmark(
+        "Single Allocations (Bump Inline (lambda: pass by r-value reference (&&)))",
+        100,
+        [](bump::bump_inline<4096> &&allocator)
+        {
+            int *i = allocator.allocate<int>(1);
+            *i = 42;
+            benchmark::do_not_optimize(i);
+
+            // Every call measures an allocation from a fresh pool
+            allocator.reset();
+        },
+        bump::bump_inline<4096>()
+    );
+    std::cout << "Average time taken per run: " << bench_single_allocations_binline << "ns\n\n";
+
     // Bump Up Big Allocations l-value reference
     auto bench_big_allocations_bup = benchmark::run_benchmark(
         "Big Allocations (Bump Up (lambda: pass by r-value reference (&&)))", 
@@ -61,7 +168,11 @@ int main()
             int* i = allocator.allocate<int>(100);
             double* d = allocator.allocate<double>(100);
             char* c = allocator.allocate<char>(100);
-            short* s = allocator.allocate<short>(100); 
+            short* s = allocator.allocate<short>(100);
+            benchmark::do_not_optimize(s);
+
+            // Every call measures allocations from a fresh pool
+            allocator.reset();
         },
         bump::bump_up<1600>()
     );
@@ -76,12 +187,73 @@ int main()
             int* i = allocator.allocate<int>(100);
             double* d = allocator.allocate<double>(100);
             char* c = allocator.allocate<char>(100);
-            short* s = allocator.allocate<short>(100); 
+            short* s = allocator.allocate<short>(100);
+            benchmark::do_not_optimize(s);
+
+            // Every call measures allocations from a fresh pool
+            allocator.reset();
         },
         bump::bump_down<1600>()
     );
     std::cout << "Average time taken per run: " << bench_big_allocations_bdown << "ns\n\n";
 
+    // Bump Up Big Allocations as one batch r-value reference
+    auto bench_big_batch_allocations_bup = benchmark::run_benchmark(
+        "Big Allocations (Bump Up allocate_many (lambda: pass by r-value reference (&&)))", 
+        100, 
+        [](bump::bump_up<1600> &&allocator)
+        {
+            auto [i, d, c, s] = allocator.allocate_many<int, double, char, short>(100, 100, 100, 100);
+            benchmark::do_not_optimize(i);
+            benchmark::do_not_optimize(d);
+            benchmark::do_not_optimize(c);
+            benchmark::do_not_optimize(s);
+
+            // Every call measures allocations from a fresh pool
+            allocator.reset();
+        },
+        bump::bump_up<1600>()
+    );
+    std::cout << "Average time taken per run: " << bench_big_batch_allocations_bup << "ns\n\n";
+
+    // Bump Down Big Allocations as one batch r-value reference
+    auto bench_big_batch_allocations_bdown = benchmark::run_benchmark(
+        "Big Allocations (Bump Down allocate_many (lambda: pass by r-value reference (&&)))", 
+        100, 
+        [](bump::bump_down<1600> &&allocator)
+        {
+            auto [i, d, c, s] = allocator.allocate_many<int, double, char, short>(100, 100, 100, 100);
+            benchmark::do_not_optimize(i);
+            benchmark::do_not_optimize(d);
+            benchmark::do_not_optimize(c);
+            benchmark::do_not_optimize(s);
+
+            // Every call measures allocations from a fresh pool
+            allocator.reset();
+        },
+        bump::bump_down<1600>()
+    );
+    std::cout << "Average time taken per run: " << bench_big_batch_allocations_bdown << "ns\n\n";
+
+    // Bump Inline Big Allocations r-value reference
+    auto bench_big_allocations_binline = benchmark::run_benchmark(
+        "Big Allocations (Bump Inline (lambda: pass by r-value reference (&&)))", 
+        100, 
+        [](bump::bump_inline<1600> &&allocator)
+        {
+            int* i = allocator.allocate<int>(100);
+            double* d = allocator.allocate<double>(100);
+            char* c = allocator.allocate<char>(100);
+            short* s = allocator.allocate<short>(100);
+            benchmark::do_not_optimize(s);
+
+            // Every call measures allocations from a fresh pool
+            allocator.reset();
+        },
+        bump::bump_inline<1600>()
+    );
+    std::cout << "Average time taken per run: " << bench_big_allocations_binline << "ns\n\n";
+
     // Bump Uo Mixed Size Allocations void function(void)
     auto bench_mixed_size_allocations_bup = benchmark::run_benchmark("Mixed Size Allocations (Bump Up (void function(void)))", 100, MixedSizeAllocationsBumpUp);
     std::cout << "Average time taken per run: " << bench_mixed_size_allocations_bup << "ns\n\n";
@@ -110,6 +282,18 @@ int main()
     );
     std::cout << "Average time taken per run: " << bench_rvr_loop_alloc_and_dealloc_bup << "ns\n\n";
 
+    // Bump Up Loop Allocations and Reset l-value reference
+    auto bench_loop_allocations_and_reset_bup = benchmark::run_benchmark("Loop Allocations and Reset (Bump Up (void function(pass by l-value ref (&))))", 100, LoopAllocationAndResetBumpUp, bup_allocator);
+    std::cout << "Average time taken per run: " << bench_loop_allocations_and_reset_bup << "ns\n\n";
+
+    // Bump Up Nested Scoped Allocations l-value reference
+    auto bench_nested_scoped_allocations_bup = benchmark::run_benchmark("Nested Scoped Allocations (Bump Up (void function(pass by l-value ref (&))))", 100, NestedScopedAllocationsBumpUp, bup_allocator);
+    std::cout << "Average time taken per run: " << bench_nested_scoped_allocations_bup << "ns\n\n";
+
+    // Bump Up Object Construction l-value reference
+    auto bench_make_objects_bup = benchmark::run_benchmark("Make Objects (Bump Up (void function(pass by l-value ref (&))))", 100, MakeObjectsBumpUp, bup_allocator);
+    std::cout << "Average time taken per run: " << bench_make_objects_bup << "ns\n\n";
+
     // Bump Down Loop Allocations and Deallocation l-value reference
     bump::bump_down<4096> bdown_allocator;
     auto bench_loop_allocations_and_deallocation_bdown = benchmark::run_benchmark("Loop Allocations and Deallocation (Bump Down (void function(pass by l-value ref (&))))", 1, LoopAllocationAndDeallocationBumpDown, bdown_allocator);
@@ -129,6 +313,154 @@ int main()
         bump::bump_down<4096>()
     );
     std::cout << "Average time taken per run: " << bench_rvr_loop_alloc_and_dealloc_bdown << "ns\n\n";
+
+    // Bump Down Loop Allocations and Reset l-value reference
+    auto bench_loop_allocations_and_reset_bdown = benchmark::run_benchmark("Loop Allocations and Reset (Bump Down (void function(pass by l-value ref (&))))", 100, LoopAllocationAndResetBumpDown, bdown_allocator);
+    std::cout << "Average time taken per run: " << bench_loop_allocations_and_reset_bdown << "ns\n\n";
+
+    // Results from the bottom and scratch from the top of one pool vs two worst-case pools
+    bump::bump_double_ended<8192> double_ended;
+    auto bench_double_ended = benchmark::run_benchmark("Results and Scratch (Bump Double Ended (void function(pass by l-value ref (&))))", 100, ResultsAndScratchDoubleEnded, double_ended);
+    std::cout << "Average time taken per run: " << bench_double_ended << "ns\n\n";
+
+    bump::bump_up<4096> results_arena;
+    bump::bump_down<4096> scratch_arena;
+    auto bench_separate_arenas = benchmark::run_benchmark("Results and Scratch (Bump Up + Bump Down (void function(pass by l-value ref (&))))", 100, ResultsAndScratchSeparate, results_arena, scratch_arena);
+    std::cout << "Average time taken per run: " << bench_separate_arenas << "ns\n\n";
+
+    // Growable buffer: in-place reallocate vs allocating a bigger block and copying every time
+    bump::bump_up<65536> buffer_arena;
+    auto bench_growable_reallocate = benchmark::run_benchmark("Growable Buffer (Bump Up reallocate (void function(pass by l-value ref (&))))", 100, GrowableBufferReallocateBumpUp, buffer_arena);
+    std::cout << "Average time taken per run: " << bench_growable_reallocate << "ns\n\n";
+
+    auto bench_growable_copy = benchmark::run_benchmark("Growable Buffer (Bump Up allocate and copy (void function(pass by l-value ref (&))))", 100, GrowableBufferCopyBumpUp, buffer_arena);
+    std::cout << "Average time taken per run: " << bench_growable_copy << "ns\n\n";
+
+    // pmr containers on a bump_up arena vs std::pmr::monotonic_buffer_resource over a buffer of the same size
+    bump::bump_up<65536> pmr_arena;
+    auto bench_pmr_bump_resource = benchmark::run_benchmark("PMR Containers (bump_resource over Bump Up (void function(pass by l-value ref (&))))", 100, PmrContainersBumpResource, pmr_arena);
+    std::cout << "Average time taken per run: " << bench_pmr_bump_resource << "ns\n\n";
+
+    auto bench_pmr_monotonic = benchmark::run_benchmark("PMR Containers (std::pmr::monotonic_buffer_resource (void function(void)))", 100, PmrContainersMonotonicBufferResource);
+    std::cout << "Average time taken per run: " << bench_pmr_monotonic << "ns\n\n";
+
+    // Thread-local arenas fed from one shared supplier vs new/delete, one worker per hardware thread
+    bump::chunk_supplier<65536> supplier;
+    auto bench_thread_arenas = benchmark::run_benchmark("Threaded Allocations (thread_arena per thread (void function(pass by l-value ref (&))))", 10, ThreadArenaAllocations, supplier);
+    std::cout << "Average time taken per run: " << bench_thread_arenas << "ns\n\n";
+
+    auto bench_thread_heap = benchmark::run_benchmark("Threaded Allocations (new/delete per thread (void function(void)))", 10, ThreadHeapAllocations);
+    std::cout << "Average time taken per run: " << bench_thread_heap << "ns\n\n";
+
+    // Contention on one shared pool: lock-free concurrent_bump_up vs bump_up behind a mutex
+    static bump::concurrent_bump_up<1 << 24> shared_concurrent;
+    auto bench_shared_concurrent = benchmark::run_benchmark("Shared Allocations (Concurrent Bump Up (void function(pass by l-value ref (&))))", 10, SharedAllocationsConcurrentBumpUp, shared_concurrent);
+    std::cout << "Average time taken per run: " << bench_shared_concurrent << "ns\n\n";
+
+    static bump::bump_up<1 << 24> shared_locked;
+    auto bench_shared_locked = benchmark::run_benchmark("Shared Allocations (Bump Up with std::mutex (void function(pass by l-value ref (&))))", 10, SharedAllocationsMutexBumpUp, shared_locked);
+    std::cout << "Average time taken per run: " << bench_shared_locked << "ns\n\n";
+
+    // First touch of every page: the heap arena faults here, the mapped arena already did so in its constructor
+    static heap_arena heap_pages;
+    auto bench_first_touch_heap = benchmark::run_benchmark("First Touch 64MB (Bump Up heap backing (void function(pass by l-value ref (&))))", 1, FirstTouch<heap_arena>, heap_pages);
+    std::cout << "Average time taken per run: " << bench_first_touch_heap << "ns\n\n";
+
+    static huge_arena huge_pages;
+    auto bench_first_touch_huge = benchmark::run_benchmark("First Touch 64MB (Bump Up pre-faulted huge page backing (void function(pass by l-value ref (&))))", 1, FirstTouch<huge_arena>, huge_pages);
+    std::cout << "Average time taken per run: " << bench_first_touch_huge << "ns\n\n";
+
+    // Random reads across the whole arena, dominated by TLB misses on 4KB pages
+    auto bench_random_access_heap = benchmark::run_benchmark("Random Access 64MB (Bump Up heap backing (void function(pass by l-value ref (&))))", 10, RandomAccess<heap_arena>, heap_pages);
+    std::cout << "Average time taken per run: " << bench_random_access_heap << "ns\n\n";
+
+    auto bench_random_access_huge = benchmark::run_benchmark("Random Access 64MB (Bump Up pre-faulted huge page backing (void function(pass by l-value ref (&))))", 10, RandomAccess<huge_arena>, huge_pages);
+    std::cout << "Average time taken per run: " << bench_random_access_huge << "ns\n\n";
+
+    // Build a lookup table in a file once, then map it back in read-only instead of rebuilding it
+    auto bench_build_persistent = benchmark::run_benchmark("Persistent Lookup Table (build in file_arena and sync (void function(void)))", 1, BuildPersistentTable);
+    std::cout << "Average time taken per run: " << bench_build_persistent << "ns\n\n";
+
+    auto bench_map_persistent = benchmark::run_benchmark("Persistent Lookup Table (map read-only and walk (void function(void)))", 1, MapPersistentTable);
+    std::cout << "Average time taken per run: " << bench_map_persistent << "ns\n\n";
+    std::remove("lookup.arena");
+
+    // Cost of logging every allocation to a trace file that make replay can feed into other allocators
+    static bump::bump_up<65536> request_arena;
+    auto bench_plain_requests = benchmark::run_benchmark("Request Allocations (Bump Up (void function(pass by l-value ref (&))))", 100, RequestAllocations<bump::bump_up<65536>>, request_arena);
+    std::cout << "Average time taken per run: " << bench_plain_requests << "ns\n\n";
+
+    {
+        bump::trace_writer writer("requests.trace");
+        bump::recording<bump::bump_up<65536>> recorded(request_arena, writer);
+        auto bench_recorded_requests = benchmark::run_benchmark("Request Allocations (recording Bump Up to a trace (void function(pass by l-value ref (&))))", 100, RequestAllocations<bump::recording<bump::bump_up<65536>>>, recorded);
+        std::cout << "Average time taken per run: " << bench_recorded_requests << "ns\n\n";
+    }
+    std::remove("requests.trace");
+
+    // Nodes freed and replaced inside one arena lifetime: size-class free lists keep a 4KB pool enough
+    static bump::bump_up<4096> node_arena;
+    bump::recycling<bump::bump_up<4096>> node_pool(node_arena);
+    auto bench_churn_recycling = benchmark::run_benchmark("Node Churn (recycling over Bump Up (void function(pass by l-value ref (&))))", 100, NodeChurnRecycling, node_pool);
+    std::cout << "Average time taken per run: " << bench_churn_recycling << "ns\n\n";
+
+    auto bench_churn_heap = benchmark::run_benchmark("Node Churn (new/delete (void function(void)))", 100, NodeChurnHeap);
+    std::cout << "Average time taken per run: " << bench_churn_heap << "ns\n\n";
+
+    // Fixed size slots with no header, bumped in batches of 64
+    static bump::slab<churn_node> node_slab;
+    auto bench_churn_slab = benchmark::run_benchmark("Node Churn (slab (void function(pass by l-value ref (&))))", 100, NodeChurnSlab, node_slab);
+    std::cout << "Average time taken per run: " << bench_churn_slab << "ns\n\n";
+
+    auto bench_bursts_slab = benchmark::run_benchmark("Node Bursts (slab (void function(pass by l-value ref (&))))", 100, NodeBurstsSlab, node_slab);
+    std::cout << "Average time taken per run: " << bench_bursts_slab << "ns\n\n";
+
+    auto bench_bursts_heap = benchmark::run_benchmark("Node Bursts (new/delete (void function(void)))", 100, NodeBurstsHeap);
+    std::cout << "Average time taken per run: " << bench_bursts_heap << "ns\n\n";
+
+    // Small allocations with and without a size quantum, run with --counters to compare instructions per run
+    static bump::bump_up<4096> unquantised;
+    static quantised_arena quantised;
+    auto bench_small_unquantised = benchmark::run_benchmark("Small Mixed Allocations (Bump Up (void function(pass by l-value ref (&))))", 100, SmallMixedAllocations<bump::bump_up<4096>>, unquantised);
+    std::cout << "Average time taken per run: " << bench_small_unquantised << "ns\n\n";
+
+    auto bench_small_quantised = benchmark::run_benchmark("Small Mixed Allocations (Bump Up, 8 byte quantum (void function(pass by l-value ref (&))))", 100, SmallMixedAllocations<quantised_arena>, quantised);
+    std::cout << "Average time taken per run: " << bench_small_quantised << "ns\n\n";
+
+    // The vector, string and map a request handler builds, in the arena and with the std containers
+    static bump::bump_up<65536> container_arena;
+    auto bench_request_containers_bup = benchmark::run_benchmark("Request Containers (Bump Up (void function(pass by l-value ref (&))))", 100, RequestContainersBumpUp, container_arena);
+    std::cout << "Average time taken per run: " << bench_request_containers_bup << "ns\n\n";
+
+    auto bench_request_containers_std = benchmark::run_benchmark("Request Containers (std (void function(void)))", 100, RequestContainersStd);
+    std::cout << "Average time taken per run: " << bench_request_containers_std << "ns\n\n";
+
+    // Tokens of a parsed batch interned once each, against one heap string per token
+    static symbol_arena symbols;
+    static bump::interner<symbol_arena> token_table(symbols);
+    auto bench_tokens_interned = benchmark::run_benchmark("Parse Tokens (interner (void function(pass by l-value ref (&))))", 100, ParseTokensInterned, token_table);
+    std::cout << "Average time taken per run: " << bench_tokens_interned << "ns\n\n";
+
+    auto bench_tokens_heap = benchmark::run_benchmark("Parse Tokens (std::string per token (void function(void)))", 100, ParseTokensHeapStrings);
+    std::cout << "Average time taken per run: " << bench_tokens_heap << "ns\n\n";
+
+    // A 1M element vector grown one push at a time, contiguous in a reservation and in segments across chunks
+    static reserved_arena reservation;
+    static chained_arena chained;
+    auto bench_vector_reserved = benchmark::run_benchmark("Vector Growth (Bump Up reserved (void function(pass by l-value ref (&))))", 20, VectorGrowth<reserved_arena>, reservation);
+    std::cout << "Average time taken per run: " << bench_vector_reserved << "ns\n";
+    std::cout << "Committed: " << reservation.committed_bytes() / 1024 << "KB";
+    reservation.reset(bump::release::dont_need, 1 << 20);
+    std::cout << ", after reset(release::dont_need, 1MB): " << reservation.committed_bytes() / 1024 << "KB\n\n";
+
+    auto bench_vector_chained = benchmark::run_benchmark("Vector Growth (Bump Up geometric chunks (void function(pass by l-value ref (&))))", 20, VectorGrowth<chained_arena>, chained);
+    std::cout << "Average time taken per run: " << bench_vector_chained << "ns\n\n";
+
+    auto bench_vector_std = benchmark::run_benchmark("Vector Growth (std::vector (void function(void)))", 20, VectorGrowthStd);
+    std::cout << "Average time taken per run: " << bench_vector_std << "ns\n\n";
+
+    // Write every result as JSON or CSV when requested
+    benchmark::finish();
 }
 
 void MixedSizeAllocationsBumpUp(void)
@@ -191,4 +523,482 @@ void LoopAllocationAndDeallocationBumpDown(bump::bump_down<4096> &allocator)
         allocator.allocate<int>(1);
     }
     allocator.deallocate();
-}
\ No newline at end of file
+}
+
+void LoopAllocationAndResetBumpUp(bump::bump_up<4096> &allocator)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        allocator.allocate<int>(1);
+    }
+    allocator.reset();
+}
+
+void LoopAllocationAndResetBumpDown(bump::bump_down<4096> &allocator)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        allocator.allocate<int>(1);
+    }
+    allocator.reset();
+}
+
+void NestedScopedAllocationsBumpUp(bump::bump_up<4096> &allocator)
+{
+    // Parse output outlives the transform temporaries, which reuse the same bytes on every pass
+    int *parsed = allocator.allocate<int>(64);
+    for (int pass = 0; pass < 10; ++pass)
+    {
+        bump::scope transform(allocator);
+        double *temporaries = allocator.allocate<double>(128);
+        temporaries[0] = parsed[0] = pass;
+    }
+    allocator.reset();
+}
+
+// Builds the same vector and hash map on any memory resource
+static void PmrContainers(std::pmr::memory_resource *resource)
+{
+    std::pmr::vector<int> values(resource);
+    std::pmr::unordered_map<int, double> index(resource);
+    for (int i = 0; i < 256; ++i)
+    {
+        values.push_back(i);
+        index[i] = i * 0.5;
+    }
+}
+
+void PmrContainersBumpResource(bump::bump_up<65536> &allocator)
+{
+    bump::bump_resource<bump::bump_up<65536>> resource(allocator);
+    PmrContainers(&resource);
+    allocator.reset();
+}
+
+void PmrContainersMonotonicBufferResource(void)
+{
+    static bump::byte buffer[65536];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    PmrContainers(&resource);
+}
+
+// Number of workers used by the threaded benchmarks
+static unsigned WorkerCount(void)
+{
+    unsigned workers = std::thread::hardware_concurrency();
+    return workers ? workers : 1;
+}
+
+void ThreadArenaAllocations(bump::chunk_supplier<65536> &supplier)
+{
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < WorkerCount(); ++w)
+    {
+        workers.emplace_back([&supplier]()
+        {
+            bump::thread_arena<65536> allocator(supplier);
+            for (int request = 0; request < 100; ++request)
+            {
+                for (int i = 0; i < 100; ++i)
+                {
+                    int *x = allocator.allocate<int>(4);
+                    x[0] = i;
+                }
+                allocator.reset();
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+void ThreadHeapAllocations(void)
+{
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < WorkerCount(); ++w)
+    {
+        workers.emplace_back([]()
+        {
+            int *live[100];
+            for (int request = 0; request < 100; ++request)
+            {
+                for (int i = 0; i < 100; ++i)
+                {
+                    live[i] = new int[4];
+                    live[i][0] = i;
+                }
+                for (int i = 0; i < 100; ++i)
+                    delete[] live[i];
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+void SharedAllocationsConcurrentBumpUp(bump::concurrent_bump_up<1 << 24> &allocator)
+{
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < WorkerCount(); ++w)
+    {
+        workers.emplace_back([&allocator]()
+        {
+            for (int i = 0; i < 10000; ++i)
+            {
+                int *x = allocator.allocate<int>(4);
+                if (x)
+                    x[0] = i;
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+    allocator.reset();
+}
+
+void SharedAllocationsMutexBumpUp(bump::bump_up<1 << 24> &allocator)
+{
+    std::mutex lock;
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < WorkerCount(); ++w)
+    {
+        workers.emplace_back([&allocator, &lock]()
+        {
+            for (int i = 0; i < 10000; ++i)
+            {
+                int *x;
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    x = allocator.allocate<int>(4);
+                }
+                if (x)
+                    x[0] = i;
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+    allocator.reset();
+}
+
+template <class Allocator>
+void FirstTouch(Allocator &allocator)
+{
+    char *region = allocator.template allocate<char>(64 << 20);
+    for (std::size_t offset = 0; offset < (64 << 20); offset += 4096)
+        region[offset] = 1;
+    allocator.reset();
+}
+
+template <class Allocator>
+void RandomAccess(Allocator &allocator)
+{
+    volatile char *region = allocator.template allocate<char>(64 << 20);
+    std::uint64_t state = 88172645463325252ULL;
+    for (int i = 0; i < 100000; ++i)
+    {
+        // xorshift64 to pick offsets all over the arena
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        region[state % (64 << 20)];
+    }
+    allocator.reset();
+}
+
+// Entry of the persistent lookup table, linked with offset pointers so it survives remapping
+struct lookup_entry
+{
+    int key;
+    double value;
+    bump::offset_ptr<lookup_entry> next;
+};
+
+void BuildPersistentTable(void)
+{
+    bump::file_arena arena("lookup.arena", 8 << 20);
+    lookup_entry *head = nullptr;
+    for (int i = 0; i < 100000; ++i)
+    {
+        lookup_entry *entry = arena.allocate<lookup_entry>(1);
+        entry->key = i;
+        entry->value = i * 0.5;
+        entry->next = head;
+        head = entry;
+    }
+    arena.set_root(head);
+    arena.sync();
+}
+
+void MapPersistentTable(void)
+{
+    bump::file_arena arena("lookup.arena");
+    double total = 0.0;
+    for (lookup_entry *entry = arena.root<lookup_entry>(); entry; entry = entry->next.get())
+        total += entry->value;
+    if (total < 0.0)
+        std::cerr << "Error: Persistent lookup table is corrupt.\n";
+}
+
+void MakeObjectsBumpUp(bump::bump_up<4096> &allocator)
+{
+    struct point
+    {
+        double x;
+        double y;
+    };
+
+    // Points are trivially destructible and take no destructor record, the strings do
+    point *points = allocator.make_array<point>(64, point{1.0, 2.0});
+    std::string *name = allocator.make<std::string>("request scoped name that does not fit in place");
+    points[0].x = static_cast<double>(name->size());
+    allocator.reset();
+}
+
+void GrowableBufferReallocateBumpUp(bump::bump_up<65536> &allocator)
+{
+    std::size_t capacity = 8;
+    int *buffer = allocator.allocate<int>(capacity);
+    for (std::size_t size = 0; size < 4096; ++size)
+    {
+        if (size == capacity)
+        {
+            buffer = allocator.reallocate(buffer, capacity, capacity * 2);
+            capacity *= 2;
+        }
+        buffer[size] = static_cast<int>(size);
+    }
+    allocator.reset();
+}
+
+void GrowableBufferCopyBumpUp(bump::bump_up<65536> &allocator)
+{
+    std::size_t capacity = 8;
+    int *buffer = allocator.allocate<int>(capacity);
+    for (std::size_t size = 0; size < 4096; ++size)
+    {
+        if (size == capacity)
+        {
+            int *bigger = allocator.allocate<int>(capacity * 2);
+            std::memcpy(bigger, buffer, sizeof(int) * capacity);
+            buffer = bigger;
+            capacity *= 2;
+        }
+        buffer[size] = static_cast<int>(size);
+    }
+    allocator.reset();
+}
+
+void ResultsAndScratchDoubleEnded(bump::bump_double_ended<8192> &allocator)
+{
+    for (int phase = 0; phase < 10; ++phase)
+    {
+        double *scratch = allocator.allocate_down<double>(64);
+        int *result = allocator.allocate_up<int>(16);
+        result[0] = static_cast<int>(scratch[0] = phase);
+        allocator.reset_down();
+    }
+    allocator.reset();
+}
+
+void ResultsAndScratchSeparate(bump::bump_up<4096> &results, bump::bump_down<4096> &scratch_pool)
+{
+    for (int phase = 0; phase < 10; ++phase)
+    {
+        double *scratch = scratch_pool.allocate<double>(64);
+        int *result = results.allocate<int>(16);
+        result[0] = static_cast<int>(scratch[0] = phase);
+        scratch_pool.reset();
+    }
+    results.reset();
+}
+
+// Allocations of a request handler: a header, a name and a result array per request, released together
+template <class Allocator>
+void RequestAllocations(Allocator &allocator)
+{
+    for (int request = 0; request < 4; ++request)
+    {
+        int *header = allocator.template allocate<int>(4);
+        char *name = allocator.template allocate<char>(24 + request * 8);
+        double *result = allocator.template allocate<double>(16);
+        header[0] = name[0] = static_cast<char>(request);
+        result[0] = request;
+    }
+    allocator.reset();
+}
+
+// A working set of 64 nodes where one node is freed and replaced on every step
+void NodeChurnRecycling(bump::recycling<bump::bump_up<4096>> &nodes)
+{
+    churn_node *live[64];
+    for (int i = 0; i < 64; ++i)
+        live[i] = nodes.allocate<churn_node>(1);
+
+    for (int step = 0; step < 1000; ++step)
+    {
+        int slot = (step * 7) % 64;
+        nodes.deallocate(live[slot], 1);
+        live[slot] = nodes.allocate<churn_node>(1);
+        live[slot]->key = step;
+    }
+    nodes.reset();
+}
+
+void NodeChurnHeap(void)
+{
+    churn_node *live[64];
+    for (int i = 0; i < 64; ++i)
+        live[i] = new churn_node;
+
+    for (int step = 0; step < 1000; ++step)
+    {
+        int slot = (step * 7) % 64;
+        delete live[slot];
+        live[slot] = new churn_node;
+        live[slot]->key = step;
+    }
+    for (churn_node *node : live)
+        delete node;
+}
+
+void NodeChurnSlab(bump::slab<churn_node> &nodes)
+{
+    churn_node *live[64];
+    for (int i = 0; i < 64; ++i)
+        live[i] = nodes.make();
+
+    for (int step = 0; step < 1000; ++step)
+    {
+        int slot = (step * 7) % 64;
+        nodes.destroy(live[slot]);
+        live[slot] = nodes.make();
+        live[slot]->key = step;
+    }
+    for (churn_node *node : live)
+        nodes.destroy(node);
+}
+
+// Build up 512 nodes, free every other one, refill the gaps, then free everything
+void NodeBurstsSlab(bump::slab<churn_node> &nodes)
+{
+    churn_node *live[512];
+    for (int i = 0; i < 512; ++i)
+        live[i] = nodes.make();
+    for (int i = 0; i < 512; i += 2)
+        nodes.destroy(live[i]);
+    for (int i = 0; i < 512; i += 2)
+        live[i] = nodes.make();
+    for (churn_node *node : live)
+        nodes.destroy(node);
+}
+
+void NodeBurstsHeap(void)
+{
+    churn_node *live[512];
+    for (int i = 0; i < 512; ++i)
+        live[i] = new churn_node();
+    for (int i = 0; i < 512; i += 2)
+        delete live[i];
+    for (int i = 0; i < 512; i += 2)
+        live[i] = new churn_node();
+    for (churn_node *node : live)
+        delete node;
+}
+
+// Interleaved chars, ints and doubles, the alignment rounding is the only work besides the bump itself
+template <class Allocator>
+void SmallMixedAllocations(Allocator &allocator)
+{
+    for (int i = 0; i < 64; ++i)
+    {
+        char *c = allocator.template allocate<char>(3);
+        int *n = allocator.template allocate<int>(1);
+        double *d = allocator.template allocate<double>(1);
+        benchmark::do_not_optimize(c);
+        benchmark::do_not_optimize(n);
+        benchmark::do_not_optimize(d);
+    }
+    allocator.reset();
+}
+
+// One request: 256 ids, a response body built from them and an index of the ids by their remainder
+void RequestContainersBumpUp(bump::bump_up<65536> &allocator)
+{
+    bump::bump_vector<int, bump::bump_up<65536>> ids(allocator);
+    bump::bump_string<bump::bump_up<65536>> body(allocator);
+    bump::bump_map<int, int, bump::bump_up<65536>> index(allocator);
+    for (int i = 0; i < 256; ++i)
+    {
+        ids.push_back(i * 7);
+        body.append("id,");
+        index.insert(i % 97, i);
+    }
+    benchmark::do_not_optimize(ids[255] + body.size() + *index.find(3));
+    allocator.reset();
+}
+
+void RequestContainersStd(void)
+{
+    std::vector<int> ids;
+    std::string body;
+    std::unordered_map<int, int> index;
+    for (int i = 0; i < 256; ++i)
+    {
+        ids.push_back(i * 7);
+        body.append("id,");
+        index[i % 97] = i;
+    }
+    benchmark::do_not_optimize(ids[255] + body.size() + index.find(3)->second);
+}
+
+// Token i of a batch of 2048 drawn from 128 distinct identifiers longer than the small string buffer
+static std::string_view ParsedToken(int i)
+{
+    static char tokens[128][24];
+    static bool filled = false;
+    if (!filled)
+    {
+        for (int t = 0; t < 128; ++t)
+            std::snprintf(tokens[t], sizeof(tokens[t]), "identifier_number_%03d", t);
+        filled = true;
+    }
+    return tokens[(i * 37) % 128];
+}
+
+void ParseTokensInterned(bump::interner<symbol_arena> &table)
+{
+    bump::symbol parsed[2048];
+    for (int i = 0; i < 2048; ++i)
+        parsed[i] = table.intern(ParsedToken(i));
+    benchmark::do_not_optimize(parsed[0] == parsed[128]);
+    table.reset();
+}
+
+void ParseTokensHeapStrings(void)
+{
+    std::vector<std::string> parsed;
+    parsed.reserve(2048);
+    for (int i = 0; i < 2048; ++i)
+        parsed.emplace_back(ParsedToken(i));
+    benchmark::do_not_optimize(parsed[0] == parsed[128]);
+}
+
+// Reset keeps the committed pages and chained chunks, so runs after the first measure growth without page faults
+template <class Allocator>
+void VectorGrowth(Allocator &allocator)
+{
+    bump::bump_vector<long, Allocator> values(allocator);
+    for (long i = 0; i < (1 << 20); ++i)
+        values.push_back(i);
+    benchmark::do_not_optimize(values.back());
+    allocator.reset();
+}
+
+void VectorGrowthStd(void)
+{
+    std::vector<long> values;
+    for (long i = 0; i < (1 << 20); ++i)
+        values.push_back(i);
+    benchmark::do_not_optimize(values.back());
+}
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "bump.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+// File arenas are built on POSIX file mapping, unlike the rest of the library there is no fallback
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "persist.h requires a POSIX system (mmap, fcntl and unistd)."
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bump
+{
+    // Pointer stored as the distance from its own address to the target, so structures built in a
+    // file_arena stay valid wherever the file is mapped. Copying recomputes the distance for the new location.
+    template <class T>
+    class offset_ptr
+    {
+        // A distance of one byte can never reach a separate object, so it stands for nullptr
+        static constexpr std::ptrdiff_t null_offset = 1;
+
+    public:
+        offset_ptr(T *p = nullptr) { set(p); }
+        offset_ptr(const offset_ptr &other) { set(other.get()); }
+
+        offset_ptr &operator=(const offset_ptr &other)
+        {
+            set(other.get());
+            return *this;
+        }
+
+        offset_ptr &operator=(T *p)
+        {
+            set(p);
+            return *this;
+        }
+
+        T *get() const
+        {
+            if (offset == null_offset)
+                return nullptr;
+            return reinterpret_cast<T *>(const_cast<byte *>(reinterpret_cast<const byte *>(this)) + offset);
+        }
+
+        T &operator*() const { return *get(); }
+        T *operator->() const { return get(); }
+        T &operator[](std::size_t i) const { return get()[i]; }
+        explicit operator bool() const { return offset != null_offset; }
+
+        bool operator==(const offset_ptr &other) const { return get() == other.get(); }
+        bool operator!=(const offset_ptr &other) const { return get() != other.get(); }
+
+    private:
+        void set(T *p)
+        {
+            if (p == nullptr)
+                offset = null_offset;
+            else
+                offset = reinterpret_cast<const byte *>(p) - reinterpret_cast<const byte *>(this);
+        }
+
+        std::ptrdiff_t offset;
+    }; // CLASS offset_ptr
+
+    // Access modes for opening an existing file_arena
+    enum class access
+    {
+        read_only, // Map the file read-only, allocation always fails
+        read_write // Map the file shared and keep allocating after what is already there
+    };
+
+    // bump_up allocator whose pool is a memory-mapped file
+    // Structures built with offset_ptr links can be synced to disk once and later mapped back in
+    // (read-only, at any address) instead of being rebuilt piece by piece
+    class file_arena
+    {
+        // Stored at the start of the file, the allocation position persists with the data
+        struct header
+        {
+            std::uint64_t magic;
+            std::uint64_t size;
+            std::uint64_t used;
+            std::uint64_t root;
+        };
+
+        static constexpr std::uint64_t file_magic = 0x414e455241504d42ULL; // "BMPARENA"
+
+    public:
+        // Create (or truncate) the file at path and map size bytes of it for building
+        file_arena(const std::string &path, std::size_t size) : writable(true)
+        {
+            // Check if size is valid
+            if (size <= sizeof(header))
+            {
+                throw std::invalid_argument("Invalid. Size must be greater than the arena header.");
+            }
+
+            fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+                throw std::system_error(errno, std::generic_category(), "Failed to create " + path);
+
+            if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+            {
+                int error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "Failed to size " + path);
+            }
+
+            map(size);
+            *meta() = header{file_magic, size, sizeof(header), 0};
+        }
+
+        // Map an existing arena file, allocation continues after the stored contents in read_write mode
+        explicit file_arena(const std::string &path, access mode = access::read_only) : writable(mode == access::read_write)
+        {
+            fd = open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+            if (fd < 0)
+                throw std::system_error(errno, std::generic_category(), "Failed to open " + path);
+
+            struct stat info;
+            if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(header))
+            {
+                close(fd);
+                throw std::runtime_error("Invalid. " + path + " is not an arena file.");
+            }
+
+            // The stored position and root are used as offsets into the mapping, so both must lie inside the contents
+            map(static_cast<std::size_t>(info.st_size));
+            const header &stored = *meta();
+            if (stored.magic != file_magic || stored.size != pool_size || stored.used < sizeof(header) ||
+                stored.used > pool_size || stored.root >= stored.used)
+            {
+                munmap(pool, pool_size);
+                close(fd);
+                throw std::runtime_error("Invalid. " + path + " is not an arena file.");
+            }
+        }
+
+        file_arena(const file_arena &) = delete;
+        file_arena &operator=(const file_arena &) = delete;
+
+        // Destructor
+        ~file_arena()
+        {
+            munmap(pool, pool_size);
+            close(fd);
+        }
+
+        // Allocate memory for type T
+        template <class T>
+        T *allocate(std::size_t n)
+        {
+            return static_cast<T *>(allocate_bytes(sizeof(T) * n, alignof(T)));
+        }
+
+        // Allocate size bytes aligned to alignment, which must be a power of two
+        // Alignment holds within the file as long as it does not exceed the page size the file is mapped at
+        void *allocate_bytes(std::size_t size, std::size_t alignment)
+        {
+            // Check if allocation size is valid and the mapping can be written to
+            if (size < 1 || !writable)
+                return nullptr;
+
+            // Round the raw address up to the next multiple of the required alignment
+            std::uintptr_t mask = alignment - 1;
+            std::uintptr_t raw_address = reinterpret_cast<std::uintptr_t>(pool) + meta()->used;
+            std::uintptr_t aligned_address = (raw_address + mask) & ~mask;
+
+            // Check if allocation exceeds the file
+            if (reinterpret_cast<byte *>(aligned_address + size) > pool + pool_size)
+                return nullptr;
+
+            // The position is kept in the header so it is saved along with the data
+            meta()->used = aligned_address + size - reinterpret_cast<std::uintptr_t>(pool);
+            return reinterpret_cast<void *>(aligned_address);
+        }
+
+        // Record the entry point of the stored structure, found again with root() after remapping
+        // Throws std::logic_error on an arena opened read-only, whose header cannot be written
+        template <class T>
+        void set_root(T *p)
+        {
+            if (!writable)
+                throw std::logic_error("Invalid. Cannot set the root of a read-only arena.");
+
+            meta()->root = p ? static_cast<std::uint64_t>(reinterpret_cast<byte *>(p) - pool) : 0;
+        }
+
+        // Entry point recorded with set_root(), nullptr if none was set
+        template <class T>
+        T *root() const
+        {
+            return meta()->root ? reinterpret_cast<T *>(pool + meta()->root) : nullptr;
+        }
+
+        // Flush every modified page of the mapping to the file
+        void sync()
+        {
+            if (writable && msync(pool, pool_size, MS_SYNC) != 0)
+                throw std::system_error(errno, std::generic_category(), "Failed to sync arena");
+        }
+
+        // Number of bytes of the file in use, including the header
+        std::size_t used() const { return meta()->used; }
+
+        // Print the next address in the pool
+        void print_next_addr() const
+        {
+            std::cout << "Address: " << reinterpret_cast<std::uintptr_t>(pool + meta()->used) << std::endl;
+        }
+
+    private:
+        void map(std::size_t size)
+        {
+            int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+            void *mapping = mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                int error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "Failed to map arena file");
+            }
+
+            pool = static_cast<byte *>(mapping);
+            pool_size = size;
+        }
+
+        header *meta() const { return reinterpret_cast<header *>(pool); }
+
+        // Private members
+        byte *pool;
+        std::size_t pool_size;
+        int fd;
+        bool writable;
+    }; // CLASS file_arena
+
+} // namespace bump
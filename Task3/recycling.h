@@ -0,0 +1,106 @@
+#pragma once
+
+#include "bump.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace bump
+{
+    // Layer over a bump allocator (bump_up or bump_down) that lets small blocks be freed and reused
+    // Requests of up to MaxSize bytes are rounded up to a multiple of Granule, and each of those size classes
+    // keeps an intrusive free list threaded through the freed blocks themselves. Allocation pops from the list
+    // before bumping, so memory stays bounded under churn. Larger or over-aligned requests go straight to the arena
+    // and freeing them is a no-op, as before. Do not rewind the arena directly, blocks on the lists would dangle.
+    template <class Arena, std::size_t MaxSize = 256, std::size_t Granule = alignof(std::max_align_t)>
+    class recycling
+    {
+        static_assert((Granule & (Granule - 1)) == 0, "Invalid. Granule must be a power of two.");
+        static_assert(Granule >= sizeof(void *), "Invalid. Granule must be able to hold a free list link.");
+        static_assert(MaxSize >= Granule && MaxSize % Granule == 0, "Invalid. MaxSize must be a multiple of Granule.");
+
+        static constexpr std::size_t class_count = MaxSize / Granule;
+
+        // Link stored in the first bytes of a free block
+        struct free_block
+        {
+            free_block *next;
+        };
+
+    public:
+        explicit recycling(Arena &arena) : arena(arena) {}
+
+        // Allocate memory for type T
+        template <class T>
+        T *allocate(std::size_t n)
+        {
+            // Check if allocation size is valid
+            if (n < 1)
+                return nullptr;
+
+            return static_cast<T *>(allocate_bytes(sizeof(T) * n, alignof(T)));
+        }
+
+        // Allocate size bytes aligned to alignment, which must be a power of two
+        void *allocate_bytes(std::size_t size, std::size_t alignment)
+        {
+            if (!is_small(size, alignment))
+                return arena.allocate_bytes(size, alignment);
+
+            // Reuse a freed block of the same class before bumping
+            std::size_t index = class_of(size);
+            if (free_lists[index])
+            {
+                free_block *block = free_lists[index];
+                free_lists[index] = block->next;
+                return block;
+            }
+
+            // Bump the whole class size so the block can later hold any request of its class
+            return arena.allocate_bytes((index + 1) * Granule, Granule);
+        }
+
+        // Return the n objects at ptr, allocated with allocate<T>(n), for reuse by later allocations of the same class
+        // Objects are not destroyed, large blocks are left as dead space until the arena is reset
+        template <class T>
+        void deallocate(T *ptr, std::size_t n)
+        {
+            deallocate_bytes(ptr, sizeof(T) * n, alignof(T));
+        }
+
+        // Return a block from allocate_bytes(size, alignment)
+        void deallocate_bytes(void *ptr, std::size_t size, std::size_t alignment)
+        {
+            if (ptr == nullptr || !is_small(size, alignment))
+                return;
+
+            std::size_t index = class_of(size);
+            free_lists[index] = new (ptr) free_block{free_lists[index]};
+        }
+
+        // Reset the arena and forget every free list, O(1) in the number of freed blocks
+        void reset()
+        {
+            for (free_block *&list : free_lists)
+                list = nullptr;
+            arena.reset();
+        }
+
+        Arena &get_arena() const { return arena; }
+
+    private:
+        static bool is_small(std::size_t size, std::size_t alignment)
+        {
+            return size >= 1 && size <= MaxSize && alignment <= Granule;
+        }
+
+        // Size class of a small request, class i holds blocks of (i + 1) * Granule bytes
+        static std::size_t class_of(std::size_t size) { return (size - 1) / Granule; }
+
+        // Private members
+        Arena &arena;
+        free_block *free_lists[class_count] = {};
+    }; // CLASS recycling
+
+} // namespace bump
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "bump.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+namespace bump
+{
+    namespace detail
+    {
+        // Alignment an arena keeps next at between allocations, 1 for arenas without a size quantum
+        template <class Arena, class = void>
+        struct cursor_alignment_of : std::integral_constant<std::size_t, 1>
+        {
+        };
+
+        template <class Arena>
+        struct cursor_alignment_of<Arena, std::void_t<decltype(Arena::cursor_alignment)>>
+            : std::integral_constant<std::size_t, Arena::cursor_alignment>
+        {
+        };
+
+        // Give a block back to an upward bumping arena if nothing has been allocated after it
+        // The end of the block is rounded up to the arena's quantum, as next was when it was allocated
+        template <class Arena>
+        void release_if_top(Arena &arena, void *p, std::size_t bytes)
+        {
+            constexpr std::size_t quantum = cursor_alignment_of<Arena>::value;
+            bytes = (bytes + quantum - 1) & ~(quantum - 1);
+
+            checkpoint top = arena.marker();
+            if (static_cast<byte *>(p) + bytes == top.next)
+                arena.rewind(checkpoint{static_cast<byte *>(p), top.chunk, top.destructors});
+        }
+    } // namespace detail
+
+    // std::pmr::memory_resource backed by an upward bumping arena (bump_up or bump_inline)
+    // Deallocation only rewinds the arena when the block is the most recent allocation, otherwise it is a no-op
+    template <class Arena>
+    class bump_resource : public std::pmr::memory_resource
+    {
+    public:
+        explicit bump_resource(Arena &arena) : arena(arena) {}
+
+        Arena &get_arena() const { return arena; }
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            // Zero sized requests still need a unique, valid pointer
+            void *p = arena.allocate_bytes(bytes ? bytes : 1, alignment);
+            if (p == nullptr)
+                throw std::bad_alloc();
+            return p;
+        }
+
+        void do_deallocate(void *p, std::size_t bytes, std::size_t) override
+        {
+            detail::release_if_top(arena, p, bytes ? bytes : 1);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        Arena &arena;
+    }; // CLASS bump_resource
+
+    // Stateful allocator meeting the standard Allocator requirements, drawing from an upward bumping arena
+    // Copies (including rebound ones) share the arena and compare equal when they point at the same one
+    template <class T, class Arena>
+    class bump_allocator
+    {
+    public:
+        typedef T value_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef bump_allocator<U, Arena> other;
+        };
+
+        explicit bump_allocator(Arena &arena) noexcept : arena(&arena) {}
+
+        template <class U>
+        bump_allocator(const bump_allocator<U, Arena> &other) noexcept : arena(other.arena) {}
+
+        T *allocate(std::size_t n)
+        {
+            void *p = arena->allocate_bytes(n ? sizeof(T) * n : 1, alignof(T));
+            if (p == nullptr)
+                throw std::bad_alloc();
+            return static_cast<T *>(p);
+        }
+
+        void deallocate(T *p, std::size_t n) noexcept
+        {
+            detail::release_if_top(*arena, p, n ? sizeof(T) * n : 1);
+        }
+
+        template <class U>
+        bool operator==(const bump_allocator<U, Arena> &other) const noexcept { return arena == other.arena; }
+
+        template <class U>
+        bool operator!=(const bump_allocator<U, Arena> &other) const noexcept { return arena != other.arena; }
+
+    private:
+        template <class U, class A>
+        friend class bump_allocator;
+
+        Arena *arena;
+    }; // CLASS bump_allocator
+
+} // namespace bump
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "bump.h"
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace bump
+{
+    // Pool of fixed size slots for objects of type T, carved from a chain of bump_up chunks
+    // Slots have no header: a free slot holds the free list link, a used one holds the object.
+    // Fresh slots are bumped N at a time and handed out from that batch, freed slots go on an intrusive
+    // free list that allocation checks first, so allocate and deallocate are both O(1).
+    template <class T, std::size_t N = 64>
+    class slab
+    {
+        static_assert(N > 0, "Invalid. Batch size must be greater than 0.");
+
+        // Storage for one object, or the link to the next free slot
+        union slot
+        {
+            slot *next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+    public:
+        // Arena the batches are bumped from, the first chunk holds one batch and later ones grow geometrically
+        typedef bump_up<sizeof(slot) * N, growth::geometric<>> arena_type;
+
+        slab() = default;
+        slab(const slab &) = delete;
+        slab &operator=(const slab &) = delete;
+
+        // Allocate an uninitialised slot for one T
+        T *allocate()
+        {
+            // Reuse a freed slot first
+            if (free)
+            {
+                slot *s = free;
+                free = free->next;
+                return reinterpret_cast<T *>(s);
+            }
+
+            // Then the current batch, bumping a new one when it is used up
+            if (fresh == fresh_end)
+            {
+                fresh = arena.template allocate<slot>(N);
+                if (fresh == nullptr)
+                    return nullptr;
+                fresh_end = fresh + N;
+            }
+            return reinterpret_cast<T *>(fresh++);
+        }
+
+        // Return a slot from allocate() to the pool, the object in it must already be destroyed
+        void deallocate(T *p)
+        {
+            if (p == nullptr)
+                return;
+
+            free = new (p) slot{free};
+        }
+
+        // Allocate a slot and construct a T in it from args
+        template <class... Args>
+        T *make(Args &&...args)
+        {
+            T *p = allocate();
+            if (p == nullptr)
+                return nullptr;
+
+            // The slot goes back on the free list if the constructor throws
+            try
+            {
+                return new (p) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                deallocate(p);
+                throw;
+            }
+        }
+
+        // Destroy an object from make() and return its slot
+        void destroy(T *p)
+        {
+            if (p == nullptr)
+                return;
+
+            p->~T();
+            deallocate(p);
+        }
+
+        // Forget every slot and reset the arena, keeping its chunks for the next batches
+        // Objects still alive are not destroyed
+        void reset()
+        {
+            free = nullptr;
+            fresh = nullptr;
+            fresh_end = nullptr;
+            arena.reset();
+        }
+
+    private:
+        // Private members
+        arena_type arena;
+        slot *free = nullptr;
+        slot *fresh = nullptr;
+        slot *fresh_end = nullptr;
+    }; // CLASS slab
+
+} // namespace bump
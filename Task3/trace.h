@@ -0,0 +1,203 @@
+#pragma once
+
+#include "bump.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace bump
+{
+    // Kinds of event stored in a trace
+    enum class trace_kind : std::uint8_t
+    {
+        allocate, // One allocation of size bytes
+        reset     // The arena was reset, everything allocated before it is released
+    };
+
+    // One fixed size trace record, written to the file as is
+    struct trace_event
+    {
+        std::uint64_t time;       // Nanoseconds since the trace was started
+        std::uint32_t size;       // Bytes requested, saturated at 4GB - 1, 0 for resets
+        trace_kind kind;
+        std::uint8_t align_log2;  // Requested alignment as a power of two
+        std::uint16_t tag;        // Caller chosen type or call site tag
+    };
+
+    static_assert(sizeof(trace_event) == 16, "Invalid. trace_event must stay 16 bytes in the file format.");
+
+    namespace detail
+    {
+        // Stored at the start of every trace file
+        struct trace_header
+        {
+            std::uint64_t magic;
+            std::uint64_t version;
+        };
+
+        constexpr std::uint64_t trace_magic = 0x4543415254504d42ULL; // "BMPTRACE"
+        constexpr std::uint64_t trace_version = 1;
+
+        // Position of the highest set bit, alignments are powers of two so this is their exact log2
+        inline std::uint8_t log2_of(std::size_t alignment)
+        {
+            std::uint8_t bits = 0;
+            while (alignment > 1)
+            {
+                alignment >>= 1;
+                ++bits;
+            }
+            return bits;
+        }
+    } // namespace detail
+
+    // Buffered writer of a binary allocation trace
+    // Events are collected in memory and written a block at a time, so recording costs a clock read and a copy
+    class trace_writer
+    {
+        static constexpr std::size_t buffer_events = 4096;
+
+    public:
+        // Create (or truncate) the trace file at path
+        explicit trace_writer(const std::string &path) : start(std::chrono::steady_clock::now())
+        {
+            file = std::fopen(path.c_str(), "wb");
+            if (file == nullptr)
+                throw std::system_error(errno, std::generic_category(), "Failed to create " + path);
+
+            detail::trace_header header{detail::trace_magic, detail::trace_version};
+            if (std::fwrite(&header, sizeof(header), 1, file) != 1)
+            {
+                int error = errno;
+                std::fclose(file);
+                throw std::system_error(error, std::generic_category(), "Failed to write " + path);
+            }
+            buffer.reserve(buffer_events);
+        }
+
+        trace_writer(const trace_writer &) = delete;
+        trace_writer &operator=(const trace_writer &) = delete;
+
+        // Destructor, writes whatever is still buffered
+        ~trace_writer()
+        {
+            write_buffer();
+            std::fclose(file);
+        }
+
+        // Append an allocation of size bytes aligned to alignment
+        void allocation(std::size_t size, std::size_t alignment, std::uint16_t tag)
+        {
+            std::uint32_t stored = static_cast<std::uint32_t>(std::min<std::size_t>(size, std::numeric_limits<std::uint32_t>::max()));
+            append(trace_event{elapsed(), stored, trace_kind::allocate, detail::log2_of(alignment), tag});
+        }
+
+        // Append a reset of the recorded arena
+        void reset() { append(trace_event{elapsed(), 0, trace_kind::reset, 0, 0}); }
+
+        // Write every buffered event to the file and flush it
+        void flush()
+        {
+            if (!write_buffer() || std::fflush(file) != 0)
+                throw std::system_error(errno, std::generic_category(), "Failed to write trace");
+        }
+
+    private:
+        std::uint64_t elapsed() const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        void append(const trace_event &event)
+        {
+            buffer.push_back(event);
+            if (buffer.size() == buffer_events)
+                write_buffer();
+        }
+
+        bool write_buffer()
+        {
+            bool written = std::fwrite(buffer.data(), sizeof(trace_event), buffer.size(), file) == buffer.size();
+            buffer.clear();
+            return written;
+        }
+
+        // Private members
+        std::FILE *file;
+        std::vector<trace_event> buffer;
+        std::chrono::steady_clock::time_point start;
+    }; // CLASS trace_writer
+
+    // Read every event of a trace file written by trace_writer
+    inline std::vector<trace_event> read_trace(const std::string &path)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr)
+            throw std::system_error(errno, std::generic_category(), "Failed to open " + path);
+
+        detail::trace_header header;
+        if (std::fread(&header, sizeof(header), 1, file) != 1 || header.magic != detail::trace_magic ||
+            header.version != detail::trace_version)
+        {
+            std::fclose(file);
+            throw std::runtime_error("Invalid. " + path + " is not a trace file.");
+        }
+
+        std::vector<trace_event> events;
+        trace_event block[256];
+        std::size_t count;
+        while ((count = std::fread(block, sizeof(trace_event), 256, file)) > 0)
+            events.insert(events.end(), block, block + count);
+
+        std::fclose(file);
+        return events;
+    }
+
+    // Wrapper around any bump allocator that logs each allocation and reset to a trace_writer
+    // The arena still does the allocating, so a recorded program behaves exactly as before
+    template <class Arena>
+    class recording
+    {
+    public:
+        recording(Arena &arena, trace_writer &writer) : arena(arena), writer(writer) {}
+
+        // Allocate memory for type T, tag identifies the type or call site in the trace
+        template <class T>
+        T *allocate(std::size_t n, std::uint16_t tag = 0)
+        {
+            if (n >= 1)
+                writer.allocation(sizeof(T) * n, alignof(T), tag);
+            return arena.template allocate<T>(n);
+        }
+
+        // Allocate size bytes aligned to alignment, which must be a power of two
+        void *allocate_bytes(std::size_t size, std::size_t alignment, std::uint16_t tag = 0)
+        {
+            if (size >= 1)
+                writer.allocation(size, alignment, tag);
+            return arena.allocate_bytes(size, alignment);
+        }
+
+        // Reset the arena and mark the point in the trace
+        void reset()
+        {
+            writer.reset();
+            arena.reset();
+        }
+
+        Arena &get_arena() const { return arena; }
+
+    private:
+        Arena &arena;
+        trace_writer &writer;
+    }; // CLASS recording
+
+} // namespace bump
@@ -0,0 +1,367 @@
+#include "../Task3/bump.h"
+#include "../Task3/containers.h"
+#include "../Task3/interner.h"
+#include "../Task3/persist.h"
+#include "../Task3/resource.h"
+#include "../Task3/slab.h"
+#include "../Task2/simpletest/simpletest.h"
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+const char *group = "Arena";
+
+// Object that logs its id when destroyed, and whose constructor throws once throw_at objects have been built
+struct tracer
+{
+    static inline std::vector<int> destroyed;
+    static inline int constructed = 0;
+    static inline int throw_at = -1;
+
+    tracer() : id(++constructed)
+    {
+        if (constructed == throw_at)
+            throw std::runtime_error("tracer constructor failed");
+    }
+
+    ~tracer() { destroyed.push_back(id); }
+
+    static void restart(int fail_at = -1)
+    {
+        destroyed.clear();
+        constructed = 0;
+        throw_at = fail_at;
+    }
+
+    int id;
+};
+
+// Hash undoing the fibonacci multiplier of bump_map, so the top four bits of a key are its home in a 16 slot table
+struct home_hash
+{
+    static constexpr std::uint64_t inverse()
+    {
+        std::uint64_t golden = 0x9E3779B97F4A7C15ULL;
+        std::uint64_t x = golden;
+        for (int i = 0; i < 5; ++i)
+            x *= 2 - golden * x;
+        return x;
+    }
+
+    std::size_t operator()(std::uint64_t key) const { return static_cast<std::size_t>(key * inverse()); }
+};
+
+// Key homed at slot home of a 16 slot bump_map, id tells keys with the same home apart
+constexpr std::uint64_t homed(std::uint64_t home, std::uint64_t id) { return home << 60 | id; }
+
+DEFINE_TEST_G(ReadOnlySetRootTest, Arena)
+{
+    const char *path = "tests.arena";
+
+    {
+        bump::file_arena arena(path, 4096);
+        int *x = arena.allocate<int>(1);
+        TEST_MESSAGE(x != nullptr, "Failed to allocate 1 int in a file arena.");
+        arena.set_root(x);
+        arena.sync();
+    }
+
+    bool exception_thrown = false;
+    {
+        bump::file_arena mapped(path);
+
+        try
+        {
+            mapped.set_root(mapped.root<int>());
+        }
+        catch (const std::logic_error &e)
+        {
+            exception_thrown = true;
+        }
+
+        TEST_MESSAGE(mapped.root<int>() != nullptr, "Root was lost after setting it on a read-only arena.");
+    }
+    std::remove(path);
+
+    TEST_MESSAGE(exception_thrown, "Failed to throw exception when setting the root of a read-only arena.");
+}
+
+DEFINE_TEST_G(DestructorOrderTest, Arena)
+{
+    tracer::restart();
+    bump::bump_up<1024> bumper;
+
+    tracer *x = bumper.make<tracer>();
+    TEST_MESSAGE(x != nullptr, "Failed to make 1 tracer.");
+
+    tracer *y = bumper.make_array<tracer>(2);
+    TEST_MESSAGE(y != nullptr, "Failed to make 2 tracers.");
+
+    bumper.reset();
+
+    TEST_MESSAGE((tracer::destroyed == std::vector<int>{3, 2, 1}), "Reset did not destroy in reverse order of construction.");
+
+    bumper.reset();
+    TEST_MESSAGE(tracer::destroyed.size() == 3, "A second reset destroyed objects again.");
+}
+
+DEFINE_TEST_G(RewindDestructorTest, Arena)
+{
+    tracer::restart();
+    bump::bump_down<1024> bumper;
+
+    tracer *x = bumper.make<tracer>();
+    TEST_MESSAGE(x != nullptr, "Failed to make 1 tracer.");
+
+    bump::checkpoint marker = bumper.marker();
+
+    tracer *y = bumper.make_array<tracer>(2);
+    TEST_MESSAGE(y != nullptr, "Failed to make 2 tracers after the checkpoint.");
+
+    bumper.rewind(marker);
+    TEST_MESSAGE((tracer::destroyed == std::vector<int>{3, 2}), "Rewind did not destroy the tracers made after the checkpoint.");
+
+    bumper.deallocate();
+    TEST_MESSAGE((tracer::destroyed == std::vector<int>{3, 2, 1}), "Deallocate did not destroy the tracer made before the checkpoint.");
+}
+
+DEFINE_TEST_G(ThrowingMakeArrayTest, Arena)
+{
+    tracer::restart(3);
+    bump::bump_up<1024> bumper;
+    bool exception_thrown = false;
+
+    try
+    {
+        bumper.make_array<tracer>(5);
+    }
+    catch (const std::runtime_error &e)
+    {
+        exception_thrown = true;
+    }
+
+    TEST_MESSAGE(exception_thrown, "Failed to pass on the exception thrown by the third constructor.");
+    TEST_MESSAGE((tracer::destroyed == std::vector<int>{2, 1}), "The tracers built before the throw were not destroyed in reverse order.");
+
+    bumper.reset();
+    TEST_MESSAGE(tracer::destroyed.size() == 2, "Reset destroyed tracers from the failed array again.");
+}
+
+DEFINE_TEST_G(ThrowingSlabMakeTest, Arena)
+{
+    tracer::restart(1);
+    bump::slab<tracer> pool;
+
+    tracer *x = pool.allocate();
+    TEST_MESSAGE(x != nullptr, "Failed to allocate 1 slot.");
+    pool.deallocate(x);
+
+    bool exception_thrown = false;
+
+    try
+    {
+        pool.make();
+    }
+    catch (const std::runtime_error &e)
+    {
+        exception_thrown = true;
+    }
+
+    TEST_MESSAGE(exception_thrown, "Failed to pass on the exception thrown by the constructor.");
+
+    tracer *y = pool.allocate();
+    TEST_MESSAGE(y == x, "The slot of the failed make was not returned to the free list.");
+}
+
+DEFINE_TEST_G(QuantumResourceRollbackTest, Arena)
+{
+    bump::bump_up<4096, bump::growth::fixed, bump::backing::heap, bump::stats::none, 8> bumper;
+    bump::bump_resource<decltype(bumper)> resource(bumper);
+
+    void *x = resource.allocate(3, 1);
+    TEST_MESSAGE(x != nullptr, "Failed to allocate 3 bytes.");
+
+    void *y = resource.allocate(5, 1);
+    TEST_MESSAGE(y != nullptr, "Failed to allocate 5 bytes.");
+
+    resource.deallocate(y, 5, 1);
+
+    void *z = resource.allocate(5, 1);
+    TEST_MESSAGE(z == y, "Deallocating the top block of a quantum arena did not roll it back.");
+}
+
+DEFINE_TEST_G(MapWrappedEraseTest, Arena)
+{
+    bump::bump_up<4096> bumper;
+    bump::bump_map<std::uint64_t, int, decltype(bumper), home_hash> map(bumper);
+
+    // Three keys homed at the last slot wrap around to slots 0 and 1, pushing the key homed at 0 to slot 2
+    const std::uint64_t keys[] = {homed(15, 1), homed(15, 2), homed(15, 3), homed(0, 4)};
+    for (int i = 0; i < 4; ++i)
+        map.insert(keys[i], i);
+
+    TEST_MESSAGE(map.erase(keys[0]), "Failed to erase the first key of the wrapped cluster.");
+    TEST_MESSAGE(map.find(keys[0]) == nullptr, "Found a key after erasing it.");
+
+    bool survivors_found = true;
+    for (int i = 1; i < 4; ++i)
+        survivors_found &= map.find(keys[i]) != nullptr && *map.find(keys[i]) == i;
+    TEST_MESSAGE(survivors_found, "Lost a key of the wrapped cluster after erasing the first.");
+    TEST_MESSAGE(map.size() == 3, "Size is wrong after erasing one of four keys.");
+
+    TEST_MESSAGE(map.insert(keys[0], 10) != nullptr, "Failed to insert a key again after erasing it.");
+
+    bool all_found = map.find(keys[0]) != nullptr && *map.find(keys[0]) == 10;
+    for (int i = 1; i < 4; ++i)
+        all_found &= map.find(keys[i]) != nullptr && *map.find(keys[i]) == i;
+    TEST_MESSAGE(all_found, "Lost a key after inserting the erased key again.");
+    TEST_MESSAGE(map.size() == 4, "Size is wrong after inserting the erased key again.");
+}
+
+DEFINE_TEST_G(MapMissingKeyTest, Arena)
+{
+    bump::bump_up<4096> bumper;
+    bump::bump_map<std::uint64_t, int, decltype(bumper), home_hash> map(bumper);
+
+    TEST_MESSAGE(map.find(homed(15, 9)) == nullptr, "Found a key in an empty map.");
+
+    map.insert(homed(15, 1), 1);
+    map.insert(homed(15, 2), 2);
+
+    TEST_MESSAGE(map.find(homed(15, 9)) == nullptr, "Found a missing key sharing the home of a wrapped cluster.");
+    TEST_MESSAGE(!map.erase(homed(15, 9)), "Erased a missing key.");
+    TEST_MESSAGE(map.size() == 2, "Size changed after erasing a missing key.");
+}
+
+DEFINE_TEST_G(MapRehashTest, Arena)
+{
+    bump::bump_up<1 << 20> bumper;
+    bump::bump_map<std::uint64_t, int, decltype(bumper)> map(bumper);
+
+    bool all_inserted = true;
+    for (int i = 0; i < 1000; ++i)
+        all_inserted &= map.insert(static_cast<std::uint64_t>(i) * 7, i) != nullptr;
+    TEST_MESSAGE(all_inserted, "Failed to insert 1000 keys.");
+
+    bool all_found = true;
+    for (int i = 0; i < 1000; ++i)
+        all_found &= map.find(static_cast<std::uint64_t>(i) * 7) != nullptr && *map.find(static_cast<std::uint64_t>(i) * 7) == i;
+    TEST_MESSAGE(all_found, "Lost a key while the table grew.");
+    TEST_MESSAGE(map.size() == 1000, "Size is wrong after growing the table.");
+}
+
+DEFINE_TEST_G(MapUpdateWithoutGrowingTest, Arena)
+{
+    // Room for the first 16 slot table but not the 32 slot one it would grow into
+    bump::bump_up<512> bumper;
+    bump::bump_map<std::uint64_t, int, decltype(bumper), home_hash> map(bumper);
+
+    for (std::uint64_t i = 0; i < 14; ++i)
+        map.insert(homed(i, 1), 1);
+
+    TEST_MESSAGE(map.insert(homed(3, 1), 2) != nullptr, "Updating a key in a full table tried to grow it.");
+    TEST_MESSAGE(*map.find(homed(3, 1)) == 2, "Failed to update the value of an existing key.");
+    TEST_MESSAGE(map.insert(homed(3, 2), 3) == nullptr, "Inserted a new key into a full table without room to grow.");
+}
+
+DEFINE_TEST_G(InternTwiceTest, Arena)
+{
+    bump::bump_up<4096> bumper;
+    bump::interner<decltype(bumper)> strings(bumper);
+
+    bump::symbol x = strings.intern("request");
+    bump::symbol y = strings.intern(std::string("request"));
+    bump::symbol z = strings.intern("response");
+
+    TEST_MESSAGE(x && y && z, "Failed to intern 3 strings.");
+    TEST_MESSAGE(x == y, "Interning the same text twice gave different symbols.");
+    TEST_MESSAGE(x != z, "Interning different text gave the same symbol.");
+    TEST_MESSAGE(x.view() == "request", "The symbol does not hold the interned text.");
+    TEST_MESSAGE(strings.size() == 2, "Interning the same text twice stored it twice.");
+}
+
+DEFINE_TEST_G(InternMissingTest, Arena)
+{
+    bump::bump_up<4096> bumper;
+    bump::interner<decltype(bumper)> strings(bumper);
+
+    TEST_MESSAGE(!strings.find("request"), "Found text in an empty interner.");
+
+    bump::symbol x = strings.intern("request");
+
+    TEST_MESSAGE(strings.find("request") == x, "Failed to find interned text.");
+    TEST_MESSAGE(!strings.find("response"), "Found text that was never interned.");
+    TEST_MESSAGE(strings.size() == 1, "Size changed after finding missing text.");
+}
+
+DEFINE_TEST_G(InternRehashTest, Arena)
+{
+    bump::bump_up<1 << 16> bumper;
+    bump::interner<decltype(bumper)> strings(bumper);
+
+    std::vector<bump::symbol> symbols;
+    for (int i = 0; i < 500; ++i)
+        symbols.push_back(strings.intern("name" + std::to_string(i)));
+
+    bool all_kept = true;
+    for (int i = 0; i < 500; ++i)
+        all_kept &= symbols[i] && strings.intern("name" + std::to_string(i)) == symbols[i];
+    TEST_MESSAGE(all_kept, "Interning text again after the table grew gave a different symbol.");
+    TEST_MESSAGE(strings.size() == 500, "Size is wrong after growing the table.");
+}
+
+DEFINE_TEST_G(InternWithoutGrowingTest, Arena)
+{
+    // Room for the first 64 slot table and its strings, but not the 128 slot one it would grow into
+    bump::bump_up<2048> bumper;
+    bump::interner<decltype(bumper)> strings(bumper);
+
+    bool all_interned = true;
+    for (int i = 0; i < 48; ++i)
+        all_interned &= static_cast<bool>(strings.intern(std::to_string(i)));
+    TEST_MESSAGE(all_interned, "Failed to intern 48 strings.");
+
+    TEST_MESSAGE(static_cast<bool>(strings.intern("7")), "Interning known text in a full table tried to grow it.");
+    TEST_MESSAGE(!strings.intern("new"), "Interned new text into a full table without room to grow.");
+}
+
+DEFINE_TEST_G(ReservationExactFitTest, Arena)
+{
+    constexpr std::size_t _1MB = 1 << 20;
+
+    struct alignas(64) line
+    {
+        char bytes[64];
+    };
+
+    bump::bump_up<_1MB, bump::growth::committed<4096>, bump::backing::reserved> bumper;
+
+    // 31 bytes of padding reach the next line, less than the 63 bytes a worst case check assumes
+    char *x = bumper.allocate<char>(33);
+    TEST_MESSAGE(x != nullptr, "Failed to allocate 33 chars.");
+
+    line *y = bumper.allocate<line>(_1MB / 64 - 1);
+    TEST_MESSAGE(y != nullptr, "Failed to allocate aligned lines ending exactly at the end of the reservation.");
+    TEST_MESSAGE(bumper.committed_bytes() == _1MB, "The whole reservation is not committed after filling it.");
+
+    char *z = bumper.allocate<char>(1);
+    TEST_MESSAGE(z == nullptr, "Allocated past the end of a full reservation.");
+
+    bumper.reset();
+
+    x = bumper.allocate<char>(33);
+    void *w = bumper.allocate_bytes(_1MB - 64, 64);
+    TEST_MESSAGE(w != nullptr, "Failed to allocate aligned bytes ending exactly at the end of the reservation.");
+}
+
+int main()
+{
+    bool pass = true;
+
+    pass &= TestFixture::ExecuteTestGroup(group, TestFixture::OutputMode::Verbose);
+
+    return pass ? 0 : 1;
+}